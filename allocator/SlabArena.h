@@ -0,0 +1,114 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_SLABARENA_H
+#define DATA_STRUCTURES_SLABARENA_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/*
+            Per container object pools
+            SlabArena carves fixed size objects out of large blocks and keeps freed ones on an
+            intrusive free list, destroying the arena releases only the blocks.
+            HeapAllocator is the plain new/delete policy with the same interface.
+                                                                        */
+
+template<class U>
+class SlabArena {
+    // a free slot stores the free list link in place of the object
+    union Slot {
+        Slot *next;
+        alignas(U) unsigned char storage[sizeof(U)];
+    };
+
+    // about 4KB of objects per block, but never fewer than 16
+    static constexpr int SLOTS_PER_BLOCK = 4096 / sizeof(Slot) > 16 ? 4096 / sizeof(Slot) : 16;
+
+    struct Block {
+        Block *next;
+        Slot slots[SLOTS_PER_BLOCK];
+    };
+
+    Block *blocks;
+    Slot *free_list;
+    // next never used slot of the newest block
+    int bump;
+
+public:
+    // destroying the arena frees every object it handed out - no need to destroy one by one
+    static constexpr bool RELEASES_ALL = true;
+
+    SlabArena() : blocks(nullptr), free_list(nullptr), bump(SLOTS_PER_BLOCK) {
+    }
+
+    ~SlabArena() {
+        while (blocks) {
+            Block *next = blocks->next;
+            delete blocks;
+            blocks = next;
+        }
+    }
+
+    SlabArena(const SlabArena &other) = delete;
+
+    SlabArena &operator=(const SlabArena &other) = delete;
+
+    template<class... Args>
+    U *create(Args &&... args) {
+        void *p = allocate();
+        try {
+            return new(p) U(std::forward<Args>(args)...);
+        } catch (...) {
+            release(p);
+            throw;
+        }
+    }
+
+    void destroy(U *p) {
+        p->~U();
+        release(p);
+    }
+
+private:
+    void *allocate() {
+        if (free_list) {
+            Slot *slot = free_list;
+            free_list = slot->next;
+            return slot->storage;
+        }
+        if (bump == SLOTS_PER_BLOCK) {
+            Block *block = new Block;
+            block->next = blocks;
+            blocks = block;
+            bump = 0;
+        }
+        return blocks->slots[bump++].storage;
+    }
+
+    void release(void *p) {
+        Slot *slot = reinterpret_cast<Slot *>(p);
+        slot->next = free_list;
+        free_list = slot;
+    }
+};
+
+template<class U>
+class HeapAllocator {
+public:
+    // every object must be destroyed on its own
+    static constexpr bool RELEASES_ALL = false;
+
+    template<class... Args>
+    U *create(Args &&... args) {
+        return new U(std::forward<Args>(args)...);
+    }
+
+    void destroy(U *p) {
+        delete p;
+    }
+};
+
+#endif //DATA_STRUCTURES_SLABARENA_H
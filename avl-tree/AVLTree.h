@@ -8,12 +8,19 @@
 #define AVLTREE_AVLTREE_H
 
 #include "cmath"
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "../binary-search-tree/EytzingerSet.h"
+#include "../binary-search-tree/NodeBlock.h"
 
 template<class T>
 class AVLTree {
 
     struct Node;
     Node *root;
+    // the nodes of fromSorted(), the others are allocated one by one
+    NodeBlock<Node, T> block;
 
     // no option for copy constructor
     AVLTree<T> &operator=(const AVLTree<T> &avl) = default;
@@ -22,15 +29,28 @@ public:
     AVLTree() : root(new Node()) {}
 
     ~AVLTree() {
-        delete root;
+        destroy(root);
     }
 
+    // other is left without a root node - it gets a new one on its next insert
+    AVLTree(AVLTree &&other) noexcept : root(other.root) {
+        other.root = nullptr;
+        block.swap(other.block);
+    }
+
+    // a balanced tree over a sorted range - O(n), no comparisons, and all the nodes in one allocation
+    template<class Iterator>
+    static AVLTree fromSorted(Iterator first, Iterator last);
+
     void insert(const T &data);
 
     void remove(const T &data);
 
     void traverse();
 
+    // an immutable copy laid out for fast lookups (../binary-search-tree/EytzingerSet.h) - O(n)
+    EytzingerSet<T> freeze() const;
+
 private:
     // should be static funcs
 
@@ -38,6 +58,24 @@ private:
 
     void traverse(Node *node);
 
+    // appends the items of the subtree in order
+    static void collect(const Node *node, std::vector<T> &items);
+
+    // the items [lo, hi) of the range first points into, as a balanced subtree
+    template<class Iterator>
+    static Node *build(NodeBlock<Node, T> &nodes, Iterator &first, std::size_t lo, std::size_t hi);
+
+    // frees the subtree without recursion
+    void destroy(Node *node);
+
+    void freeNode(Node *node) {
+        if (block.owns(node)) {
+            block.destroy(node);
+        } else {
+            delete node;
+        }
+    }
+
     int height(Node *node);
 
     void updateHeight(Node *node);
@@ -86,10 +124,8 @@ struct AVLTree<T>::Node {
 
     Node &operator=(const Node &other) = default;
 
-    // parent deleted by previous calls
+    // the children are freed by the tree (see destroy)
     ~Node() {
-        delete left;
-        delete right;
         delete data;
     }
 
@@ -143,6 +179,10 @@ struct AVLTree<T>::Node {
 
 template<class T>
 void AVLTree<T>::insert(const T &data) {
+    // a moved-from tree
+    if (root == nullptr) {
+        root = new Node();
+    }
     if (root->data == nullptr) {
         root->setData(new T(data));
     } else {
@@ -360,7 +400,7 @@ void AVLTree<T>::caseRightChild(AVLTree::Node *node) {
         }
     }
     node->right = nullptr;
-    delete node;
+    freeNode(node);
     settleViolations(right);
 }
 
@@ -379,7 +419,7 @@ void AVLTree<T>::caseLeftChild(AVLTree::Node *node) {
         }
     }
     node->left = nullptr;
-    delete node;
+    freeNode(node);
     settleViolations(left);
 }
 
@@ -387,7 +427,7 @@ template<class T>
 void AVLTree<T>::removeLeaf(AVLTree::Node *leaf) {
     Node *parent = leaf->getParent();
     if (root == leaf) {
-        delete root;
+        freeNode(root);
         root = new Node();
     } else {
         if (parent->getLeft() == leaf) {
@@ -395,7 +435,7 @@ void AVLTree<T>::removeLeaf(AVLTree::Node *leaf) {
         } else {
             parent->setRight(nullptr);
         }
-        delete leaf;
+        freeNode(leaf);
         settleViolations(parent);
     }
 }
@@ -407,9 +447,11 @@ void AVLTree<T>::caseTwoChildren(AVLTree::Node *node) {
     Node *parent = node->getParent();
     Node *predecessor = getPredecessor(left);
     Node *predecessor_parent = predecessor->getParent();
+    Node *predecessor_left = predecessor->getLeft();
 
     predecessor->setParent(parent);
     predecessor->setRight(right);
+    right->setParent(predecessor);
 
     if (parent != nullptr) {
         if (parent->getRight() == node) {
@@ -421,22 +463,111 @@ void AVLTree<T>::caseTwoChildren(AVLTree::Node *node) {
 
     node->setLeft(nullptr);
     node->setRight(nullptr);
+    if (root == node) {
+        root = predecessor;
+    }
 
     if (left == predecessor) {
-        if (root == node) {
-            root = predecessor;
-        }
-        predecessor->setLeft(nullptr);
-        delete node;
+        freeNode(node);
         settleViolations(predecessor);
     } else {
         predecessor->setLeft(left);
-        delete node;
-        predecessor_parent->setRight(nullptr);
+        left->setParent(predecessor);
+        freeNode(node);
+        // the predecessor's left subtree takes its place
+        predecessor_parent->setRight(predecessor_left);
+        if (predecessor_left) {
+            predecessor_left->setParent(predecessor_parent);
+        }
         settleViolations(predecessor_parent);
     }
 }
 
+template<class T>
+EytzingerSet<T> AVLTree<T>::freeze() const {
+    std::vector<T> items;
+    // an empty tree is a root without data
+    if (root && root->data) {
+        collect(root, items);
+    }
+    return EytzingerSet<T>(std::move(items));
+}
+
+template<class T>
+void AVLTree<T>::collect(const AVLTree::Node *node, std::vector<T> &items) {
+    if (!node) {
+        return;
+    }
+    collect(node->getLeft(), items);
+    items.push_back(*node->data);
+    collect(node->getRight(), items);
+}
+
+template<class T>
+template<class Iterator>
+AVLTree<T> AVLTree<T>::fromSorted(Iterator first, Iterator last) {
+    AVLTree<T> tree;
+    std::size_t count = std::distance(first, last);
+    if (count == 0) {
+        return tree;
+    }
+    tree.block.allocate(count);
+    Node *built;
+    try {
+        built = build(tree.block, first, 0, count);
+    } catch (...) {
+        tree.block.destroyAll();
+        throw;
+    }
+    // replaces the empty root
+    delete tree.root;
+    tree.root = built;
+    return tree;
+}
+
+template<class T>
+template<class Iterator>
+typename AVLTree<T>::Node *AVLTree<T>::build(NodeBlock<Node, T> &nodes, Iterator &first, std::size_t lo, std::size_t hi) {
+    if (lo == hi) {
+        return nullptr;
+    }
+    // the middle item is the root, built in order so the block is in order too
+    std::size_t mid = lo + (hi - lo) / 2;
+    Node *left = build(nodes, first, lo, mid);
+    Node *node = nodes.create(*first);
+    ++first;
+    Node *right = build(nodes, first, mid + 1, hi);
+    node->setLeft(left);
+    node->setRight(right);
+    if (left) {
+        left->setParent(node);
+    }
+    if (right) {
+        right->setParent(node);
+    }
+    int left_height = left ? left->getHeight() : -1;
+    int right_height = right ? right->getHeight() : -1;
+    node->setHeight(std::max(left_height, right_height) + 1);
+    return node;
+}
+
+template<class T>
+void AVLTree<T>::destroy(AVLTree::Node *node) {
+    // rotate left children up until there is none, then the node can go
+    while (node) {
+        if (node->left) {
+            Node *left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            Node *right = node->right;
+            freeNode(node);
+            node = right;
+        }
+    }
+}
+
 #endif //AVLTREE_AVLTREE_H
 
 #endif //DATA_STRUCTURES_AVLTREE_H
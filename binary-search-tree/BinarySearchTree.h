@@ -6,6 +6,11 @@
 #define DATA_STRUCTURES_BINARYSEARCHTREE_H
 #include <iostream>
 #include <exception>
+#include <iterator>
+#include <new>
+#include <vector>
+#include "EytzingerSet.h"
+#include "NodeBlock.h"
 
 class EmptyTreeException : std::exception {
 public:
@@ -20,25 +25,49 @@ public:
 template<class T>
 class BinarySearchTree {
     struct Node;
+    // nullptr while the tree is empty
     Node *head;
+    // the nodes of fromSorted(), the others are allocated one by one
+    NodeBlock<Node, T> block;
+    // scapegoat mode - the tree is kept O(log n) deep by rebuilding the subtrees that get too
+    // deep, all it needs besides the subtree sizes is the largest size since the last full rebuild
+    bool scapegoat;
+    int max_size;
 
 
 public:
-    BinarySearchTree() : head(new Node()) {
+    // scapegoat: balance the tree as a scapegoat tree (alpha = 2/3), amortized O(log n) per change
+    explicit BinarySearchTree(bool _scapegoat = false) : head(nullptr), scapegoat(_scapegoat), max_size(0) {
     }
 
     ~BinarySearchTree() {
-        delete head;
+        destroy(head);
     }
 
+    BinarySearchTree(BinarySearchTree &&other) noexcept : head(other.head), scapegoat(other.scapegoat),
+                                                          max_size(other.max_size) {
+        other.head = nullptr;
+        other.max_size = 0;
+        block.swap(other.block);
+    }
+
+    // a perfectly balanced tree over a sorted range without duplicates - O(n), no comparisons,
+    // and all the nodes in one allocation
+    template<class Iterator>
+    static BinarySearchTree fromSorted(Iterator first, Iterator last);
+
 
     void insert(const T &data) {
-        if (head->data) {
+        if (head) {
             //not the first node
-            insertNode(data, head);
+            int depth = 0;
+            if (insertNode(data, head, depth) && scapegoat) {
+                rebalanceInsert(data, depth);
+            }
         } else {
             //inserting the first node
             head = new Node(new T(data));
+            max_size = 1;
         }
     }
 
@@ -61,9 +90,48 @@ public:
 
     void remove(const T &data);
 
+    // nullptr if data is not in the tree - O(h)
+    const T *find(const T &data) const;
+
+    bool contains(const T &data) const {
+        return find(data) != nullptr;
+    }
+
+    // smallest item not less than data, nullptr if there is none - O(h)
+    const T *lowerBound(const T &data) const;
+
+    // smallest item greater than data, nullptr if there is none - O(h)
+    const T *upperBound(const T &data) const;
+
+    // calls visit on every item in [lo, hi) in order, subtrees outside the range are skipped
+    template<class Func>
+    void range(const T &lo, const T &hi, Func visit) const {
+        if (lo < hi) {
+            rangeNode(head, lo, hi, visit);
+        }
+    }
+
+    // how many items are in [lo, hi) - O(h) through the subtree sizes
+    int countRange(const T &lo, const T &hi) const {
+        int count = rank(hi) - rank(lo);
+        return count > 0 ? count : 0;
+    }
+
+    int getSize() const {
+        return head ? head->size : 0;
+    }
+
+    // an immutable copy laid out for fast lookups (./EytzingerSet.h) - O(n)
+    EytzingerSet<T> freeze() const {
+        std::vector<T> items;
+        items.reserve(getSize());
+        collect(head, items);
+        return EytzingerSet<T>(std::move(items));
+    }
+
     void traversal() const {
 
-        if (!head->data) {
+        if (!head) {
             return;
         }
         inOrderTraversal(head);
@@ -72,7 +140,49 @@ public:
 
 
 private:
-    void insertNode(const T &data, Node *node);
+    // true if data was not in the tree yet, depth is then how far below node it went
+    bool insertNode(const T &data, Node *node, int &depth);
+
+    // the new item of data went depth levels down - if that is too deep for the scapegoat
+    // bound, the lowest ancestor with more than 2/3 of its items on one side is rebuilt
+    void rebalanceInsert(const T &data, int depth);
+
+    // floor(log_3/2(size)), the deepest a scapegoat tree of size items may get
+    static int depthLimit(int size);
+
+    // the same items as a perfectly balanced subtree, made of the same nodes - O(size).
+    // if there is no memory for the list of nodes the subtree is left as it is
+    static Node *rebuild(Node *node);
+
+    // appends the nodes of the subtree in order
+    static void flatten(Node *node, std::vector<Node *> &nodes);
+
+    // links nodes [lo, hi) into a balanced subtree, returns its root
+    static Node *relink(const std::vector<Node *> &nodes, std::size_t lo, std::size_t hi);
+
+    template<class Func>
+    void rangeNode(const Node *node, const T &lo, const T &hi, Func &visit) const;
+
+    // how many items are less than data
+    int rank(const T &data) const;
+
+    // appends the items of the subtree in order
+    static void collect(const Node *node, std::vector<T> &items);
+
+    // the items [lo, hi) of the range first points into, as a balanced subtree
+    template<class Iterator>
+    static Node *build(NodeBlock<Node, T> &nodes, Iterator &first, std::size_t lo, std::size_t hi);
+
+    // frees the subtree without recursion
+    void destroy(Node *node);
+
+    void freeNode(Node *node) {
+        if (block.owns(node)) {
+            block.destroy(node);
+        } else {
+            delete node;
+        }
+    }
 
     void inOrderTraversal(Node *node) const;
 
@@ -94,7 +204,8 @@ private:
         return *node->data;
     }
 
-    void remove(const T &data, Node *&node);
+    // true if data was found and removed
+    bool remove(const T &data, Node *&node);
 };
 
 
@@ -104,16 +215,21 @@ struct BinarySearchTree<T>::Node {
     T *data;
     Node *left;
     Node *right;
+    // items in the subtree rooted here
+    int size;
+
+    explicit Node(T *_data = nullptr) : data(_data), left(nullptr), right(nullptr), size(1) {};
 
-    explicit Node(T *_data = nullptr) : data(_data), left(nullptr), right(nullptr) {};
+    static int sizeOf(const Node *node) {
+        return node ? node->size : 0;
+    }
 
     Node(const Node &other) = default;
 
     Node &operator=(const Node &other) = default;
 
+    // the children are freed by the tree (see destroy)
     ~Node() {
-        delete left;
-        delete right;
         delete data;
     }
 
@@ -122,25 +238,110 @@ struct BinarySearchTree<T>::Node {
 
 
 template<class T>
-void BinarySearchTree<T>::insertNode(const T &data, BinarySearchTree::Node *node) {
+bool BinarySearchTree<T>::insertNode(const T &data, BinarySearchTree::Node *node, int &depth) {
+    bool inserted = false;
     //if the data is smaller: we go to the left
     if (data < *node->data) {
         //let's find the location recursively where to insert
         if (node->left) {
-            insertNode(data, node->left);
+            inserted = insertNode(data, node->left, depth);
         } else {
             //no left node: this is the location where we have to insert
             node->left = new Node(new T(data));
+            inserted = true;
         }
     } else if (*node->data < data) {
         //else we have to go to the right subtree and find the location
         if (node->right) {
-            insertNode(data, node->right);
+            inserted = insertNode(data, node->right, depth);
         } else {
             //no right node: so this is where to insert
             node->right = new Node(new T(data));
+            inserted = true;
+        }
+    }
+    if (inserted) {
+        ++node->size;
+        ++depth;
+    }
+    return inserted;
+}
+
+template<class T>
+void BinarySearchTree<T>::rebalanceInsert(const T &data, int depth) {
+    if (head->size > max_size) {
+        max_size = head->size;
+    }
+    if (depth <= depthLimit(max_size)) {
+        return;
+    }
+    // walk the path again - the sizes on it tell where the weight went
+    Node **slot = &head;
+    Node **scapegoat_slot = nullptr;
+    while (true) {
+        Node *node = *slot;
+        Node **next;
+        if (data < *node->data) {
+            next = &node->left;
+        } else if (*node->data < data) {
+            next = &node->right;
+        } else {
+            break;
+        }
+        if (3 * (*next)->size > 2 * node->size) {
+            scapegoat_slot = slot;
         }
+        slot = next;
+    }
+    // a path deeper than the bound always has one
+    if (scapegoat_slot) {
+        *scapegoat_slot = rebuild(*scapegoat_slot);
+    }
+}
+
+template<class T>
+int BinarySearchTree<T>::depthLimit(int size) {
+    int limit = 0;
+    for (double reach = 1.5; reach <= size; reach *= 1.5) {
+        ++limit;
+    }
+    return limit;
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::rebuild(BinarySearchTree::Node *node) {
+    std::vector<Node *> nodes;
+    try {
+        nodes.reserve(node->size);
+    } catch (const std::bad_alloc &) {
+        return node;
+    }
+    flatten(node, nodes);
+    return relink(nodes, 0, nodes.size());
+}
+
+template<class T>
+void BinarySearchTree<T>::flatten(BinarySearchTree::Node *node, std::vector<Node *> &nodes) {
+    while (node) {
+        flatten(node->left, nodes);
+        nodes.push_back(node);
+        node = node->right;
+    }
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::relink(const std::vector<Node *> &nodes,
+                                                                std::size_t lo, std::size_t hi) {
+    if (lo == hi) {
+        return nullptr;
     }
+    // the same split as build()
+    std::size_t mid = lo + (hi - lo) / 2;
+    Node *node = nodes[mid];
+    node->left = relink(nodes, lo, mid);
+    node->right = relink(nodes, mid + 1, hi);
+    node->size = (int) (hi - lo);
+    return node;
 }
 
 // the only function with O(N) every single time.
@@ -158,40 +359,46 @@ void BinarySearchTree<T>::inOrderTraversal(BinarySearchTree::Node *node) const {
 }
 
 template<class T>
-void BinarySearchTree<T>::remove(const T &data, BinarySearchTree::Node *&node) {
+bool BinarySearchTree<T>::remove(const T &data, BinarySearchTree::Node *&node) {
     //first we have to find the node we want to remove
     if (data < *node->data) {
-        if (node->left)
-            remove(data, node->left);
-    } else if (data > *node->data) {
-        if (node->right)
-            remove(data, node->right);
+        if (node->left && remove(data, node->left)) {
+            --node->size;
+            return true;
+        }
+        return false;
+    } else if (*node->data < data) {
+        if (node->right && remove(data, node->right)) {
+            --node->size;
+            return true;
+        }
+        return false;
     } else {
 
         // we have found the node we want to remove !!!
         //removing a leaf node
         if (!node->left && !node->right) {
             std::cout << "Removing a leaf node...\n";
-            delete node;
+            freeNode(node);
             node = nullptr;
-            return;
+            return true;
         }
         //removing a right child
         if (!node->left) {
             std::cout << "Removing the right child...\n";
             Node *temp = node->right;
             node->right = nullptr;
-            delete node;
+            freeNode(node);
             node = temp;
-            return;
+            return true;
             //removing a left child
         } else if (!node->right) {
             std::cout << "Removing the left child...\n";
             Node *temp = node->left;
             node->left = nullptr;
-            delete node;
+            freeNode(node);
             node = temp;
-            return;
+            return true;
         }
 
         // we remove a node with two children case !!!
@@ -206,18 +413,24 @@ void BinarySearchTree<T>::remove(const T &data, BinarySearchTree::Node *&node) {
             predecessor->right = node->right;
         } else {
             while (temp->right && temp->right->right) {
+                // the predecessor leaves every subtree on the way down
+                --temp->size;
                 temp = temp->right;
             }
+            --temp->size;
             predecessor = temp->right;
-            temp->right = nullptr;
+            // the predecessor's left subtree takes its place
+            temp->right = predecessor->left;
             predecessor->right = node->right;
             predecessor->left = node->left;
         }
+        predecessor->size = node->size - 1;
 
         node->right = nullptr;
         node->left = nullptr;
-        delete node;
+        freeNode(node);
         node = predecessor;
+        return true;
     }
 }
 
@@ -226,7 +439,160 @@ void BinarySearchTree<T>::remove(const T &data) {
     if (!head) {
         return;
     }
-    remove(data, head);
+    if (!remove(data, head) || !scapegoat) {
+        return;
+    }
+    // the bound on the depth follows max_size, so once the tree has shrunk below 2/3 of it
+    // the whole tree is rebuilt and the bound starts over
+    if (3 * getSize() < 2 * max_size) {
+        if (head) {
+            head = rebuild(head);
+        }
+        max_size = getSize();
+    }
+}
+
+template<class T>
+const T *BinarySearchTree<T>::find(const T &data) const {
+    Node *node = head;
+    while (node) {
+        if (data < *node->data) {
+            node = node->left;
+        } else if (*node->data < data) {
+            node = node->right;
+        } else {
+            return node->data;
+        }
+    }
+    return nullptr;
+}
+
+template<class T>
+const T *BinarySearchTree<T>::lowerBound(const T &data) const {
+    Node *node = head;
+    const T *found = nullptr;
+    while (node) {
+        if (*node->data < data) {
+            node = node->right;
+        } else {
+            // a candidate - a smaller one can only be on the left
+            found = node->data;
+            node = node->left;
+        }
+    }
+    return found;
+}
+
+template<class T>
+const T *BinarySearchTree<T>::upperBound(const T &data) const {
+    Node *node = head;
+    const T *found = nullptr;
+    while (node) {
+        if (data < *node->data) {
+            found = node->data;
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    return found;
+}
+
+template<class T>
+template<class Func>
+void BinarySearchTree<T>::rangeNode(const BinarySearchTree::Node *node, const T &lo, const T &hi, Func &visit) const {
+    if (!node) {
+        return;
+    }
+    // smaller items can only be on the left if this one is above lo
+    if (lo < *node->data) {
+        rangeNode(node->left, lo, hi, visit);
+    }
+    if (!(*node->data < lo) && *node->data < hi) {
+        visit(*node->data);
+    }
+    if (*node->data < hi) {
+        rangeNode(node->right, lo, hi, visit);
+    }
+}
+
+template<class T>
+template<class Iterator>
+BinarySearchTree<T> BinarySearchTree<T>::fromSorted(Iterator first, Iterator last) {
+    BinarySearchTree<T> tree;
+    std::size_t count = std::distance(first, last);
+    if (count == 0) {
+        return tree;
+    }
+    tree.block.allocate(count);
+    try {
+        tree.head = build(tree.block, first, 0, count);
+    } catch (...) {
+        tree.block.destroyAll();
+        throw;
+    }
+    return tree;
+}
+
+template<class T>
+template<class Iterator>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::build(NodeBlock<Node, T> &nodes, Iterator &first,
+                                                               std::size_t lo, std::size_t hi) {
+    if (lo == hi) {
+        return nullptr;
+    }
+    // the middle item is the root, built in order so the block is in order too
+    std::size_t mid = lo + (hi - lo) / 2;
+    Node *left = build(nodes, first, lo, mid);
+    Node *node = nodes.create(*first);
+    ++first;
+    node->left = left;
+    node->right = build(nodes, first, mid + 1, hi);
+    node->size = (int) (hi - lo);
+    return node;
+}
+
+template<class T>
+void BinarySearchTree<T>::destroy(BinarySearchTree::Node *node) {
+    // rotate left children up until there is none, then the node can go
+    while (node) {
+        if (node->left) {
+            Node *left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            Node *right = node->right;
+            freeNode(node);
+            node = right;
+        }
+    }
+}
+
+template<class T>
+void BinarySearchTree<T>::collect(const BinarySearchTree::Node *node, std::vector<T> &items) {
+    if (!node) {
+        return;
+    }
+    collect(node->left, items);
+    items.push_back(*node->data);
+    collect(node->right, items);
+}
+
+template<class T>
+int BinarySearchTree<T>::rank(const T &data) const {
+    int count = 0;
+    Node *node = head;
+    while (node) {
+        if (*node->data < data) {
+            // the node and its whole left subtree are smaller
+            count += Node::sizeOf(node->left) + 1;
+            node = node->right;
+        } else {
+            node = node->left;
+        }
+    }
+    return count;
 }
 
 #endif //DATA_STRUCTURES_BINARYSEARCHTREE_H
@@ -0,0 +1,182 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_EYTZINGERSET_H
+#define DATA_STRUCTURES_EYTZINGERSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+            Immutable sorted set in Eytzinger (BFS) layout - what freeze() of the search trees
+            returns. the tree is implicit: the children of slot k are 2k and 2k + 1, so the
+            top levels share a few cache lines and a lookup is a branchless loop that
+            prefetches the slots a few levels below before it gets there
+                                                                        */
+
+template<class T>
+class EytzingerSet {
+    // slot 0 is never used so the root is slot 1
+    T *items;
+    std::size_t size;
+
+    static constexpr std::size_t CACHE_LINE = 64;
+    // the descendants of k that many levels down start at k * LINE_ITEMS and fill one cache line
+    static constexpr std::size_t LINE_ITEMS = sizeof(T) < CACHE_LINE ? CACHE_LINE / sizeof(T) : 1;
+    static constexpr std::size_t ALIGN = alignof(T) > CACHE_LINE ? alignof(T) : CACHE_LINE;
+
+public:
+
+    // sorted must be in order (equal items are allowed) - O(n)
+    explicit EytzingerSet(std::vector<T> sorted) : items(nullptr), size(sorted.size()) {
+        if (size == 0) {
+            return;
+        }
+        // walk the implicit tree in order, the i-th slot we reach gets the i-th item
+        std::vector<std::size_t> source(size + 1);
+        std::size_t k = 1;
+        while (2 * k <= size) {
+            k *= 2;
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            source[k] = i;
+            if (2 * k + 1 <= size) {
+                // next is the smallest slot of the right subtree
+                k = 2 * k + 1;
+                while (2 * k <= size) {
+                    k *= 2;
+                }
+            } else {
+                // climb while we come from the right, then once more
+                while (k & 1) {
+                    k >>= 1;
+                }
+                k >>= 1;
+            }
+        }
+
+        // fill the slots front to back so a throwing copy leaves a prefix to clean up
+        std::size_t count = size;
+        items = static_cast<T *>(::operator new((count + 1) * sizeof(T), std::align_val_t(ALIGN)));
+        for (size = 0; size < count; ++size) {
+            try {
+                new(items + size + 1) T(std::move(sorted[source[size + 1]]));
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+    }
+
+    EytzingerSet(EytzingerSet &&other) noexcept : items(other.items), size(other.size) {
+        other.items = nullptr;
+        other.size = 0;
+    }
+
+    EytzingerSet &operator=(EytzingerSet &&other) noexcept {
+        if (this != &other) {
+            release();
+            std::swap(items, other.items);
+            std::swap(size, other.size);
+        }
+        return *this;
+    }
+
+    EytzingerSet(const EytzingerSet &other) = delete;
+
+    EytzingerSet &operator=(const EytzingerSet &other) = delete;
+
+    ~EytzingerSet() {
+        release();
+    }
+
+    // smallest item not less than data, nullptr if there is none - O(log n)
+    const T *lowerBound(const T &data) const {
+        std::size_t k = 1;
+        while (k <= size) {
+            prefetch(k * LINE_ITEMS);
+            // no branch on the comparison, it becomes a conditional move
+            k = 2 * k + (items[k] < data);
+        }
+        return slot(k);
+    }
+
+    // smallest item greater than data, nullptr if there is none - O(log n)
+    const T *upperBound(const T &data) const {
+        std::size_t k = 1;
+        while (k <= size) {
+            prefetch(k * LINE_ITEMS);
+            k = 2 * k + !(data < items[k]);
+        }
+        return slot(k);
+    }
+
+    // nullptr if data is not in the set
+    const T *find(const T &data) const {
+        const T *found = lowerBound(data);
+        if (found && !(data < *found)) {
+            return found;
+        }
+        return nullptr;
+    }
+
+    bool contains(const T &data) const {
+        return find(data) != nullptr;
+    }
+
+    std::size_t getSize() const {
+        return size;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+private:
+    // k fell off the bottom - the answer is where the last left turn was taken, i.e. k with
+    // its trailing right turns (ones) and that left turn shifted out. 0 means no left turn
+    const T *slot(std::size_t k) const {
+        k >>= trailingOnes(k) + 1;
+        return k ? items + k : nullptr;
+    }
+
+    static unsigned trailingOnes(std::size_t k) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(~(unsigned long long) k);
+#else
+        unsigned ones = 0;
+        while (k & 1) {
+            ++ones;
+            k >>= 1;
+        }
+        return ones;
+#endif
+    }
+
+    void prefetch(std::size_t k) const {
+#if defined(__GNUC__)
+        // usually past the end near the leaves - a prefetch never faults
+        __builtin_prefetch(reinterpret_cast<const void *>(reinterpret_cast<std::uintptr_t>(items) + k * sizeof(T)));
+#else
+        (void) k;
+#endif
+    }
+
+    void release() {
+        if (!items) {
+            return;
+        }
+        for (std::size_t k = 1; k <= size; ++k) {
+            items[k].~T();
+        }
+        ::operator delete(items, std::align_val_t(ALIGN));
+        items = nullptr;
+        size = 0;
+    }
+};
+
+#endif //DATA_STRUCTURES_EYTZINGERSET_H
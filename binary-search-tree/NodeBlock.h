@@ -0,0 +1,96 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_NODEBLOCK_H
+#define DATA_STRUCTURES_NODEBLOCK_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
+
+/*
+            One allocation holding the nodes (and their items) of a tree built in bulk -
+            fromSorted() of the search trees. nodes are created in order, so an in order walk
+            reads the block front to back. a node of the block is destroyed in place when it
+            is removed from the tree, its slot is simply not reused
+                                                                        */
+
+template<class Node, class T>
+class NodeBlock {
+    void *memory;
+    Node *nodes;
+    T *items;
+    std::size_t used;
+
+    static constexpr std::size_t ALIGN = alignof(Node) > alignof(T) ? alignof(Node) : alignof(T);
+
+public:
+
+    NodeBlock() : memory(nullptr), nodes(nullptr), items(nullptr), used(0) {}
+
+    NodeBlock(const NodeBlock &other) = delete;
+
+    NodeBlock &operator=(const NodeBlock &other) = delete;
+
+    // the tree destroys every node it still holds before the block goes
+    ~NodeBlock() {
+        if (memory) {
+            ::operator delete(memory, std::align_val_t(ALIGN));
+        }
+    }
+
+    // room for count nodes - only on an empty block
+    void allocate(std::size_t count) {
+        // the items go right after the nodes
+        std::size_t node_bytes = (count * sizeof(Node) + alignof(T) - 1) / alignof(T) * alignof(T);
+        memory = ::operator new(node_bytes + count * sizeof(T), std::align_val_t(ALIGN));
+        nodes = static_cast<Node *>(memory);
+        items = reinterpret_cast<T *>(static_cast<char *>(memory) + node_bytes);
+        used = 0;
+    }
+
+    // the next node of the block, holding a copy of data
+    Node *create(const T &data) {
+        T *item = new(items + used) T(data);
+        Node *node;
+        try {
+            node = new(nodes + used) Node(item);
+        } catch (...) {
+            item->~T();
+            throw;
+        }
+        ++used;
+        return node;
+    }
+
+    bool owns(const Node *node) const {
+        std::less<const Node *> less;
+        return !less(node, nodes) && less(node, nodes + used);
+    }
+
+    // node must belong to this block
+    void destroy(Node *node) {
+        node->data->~T();
+        node->data = nullptr;
+        node->~Node();
+    }
+
+    // undoes every create() - for a build that failed before the tree took the nodes
+    void destroyAll() {
+        for (std::size_t i = 0; i < used; ++i) {
+            destroy(nodes + i);
+        }
+        used = 0;
+    }
+
+    void swap(NodeBlock &other) {
+        std::swap(memory, other.memory);
+        std::swap(nodes, other.nodes);
+        std::swap(items, other.items);
+        std::swap(used, other.used);
+    }
+};
+
+#endif //DATA_STRUCTURES_NODEBLOCK_H
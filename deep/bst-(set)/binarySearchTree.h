@@ -3,7 +3,13 @@
 
 #include <iostream>
 #include <vector>
+#include <atomic>
 #include <exception>
+#include <future>
+#include <initializer_list>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <cassert>
 
 
@@ -17,43 +23,64 @@ public:
 
 };
 
+/*
+            The set is kept weight balanced (Adams' trees, the sizes are already in the nodes):
+            neither subtree of a node holds more than DELTA times the items of the other, one
+            rotation per node on the way up restores it after an insert or a remove.
+            the set operations are built on join (link) and split, so they walk only the parts of
+            the trees that interleave, and the two halves of each step run in parallel.
+            nodes are reference counted and shared between copies: a copy is O(1), and a change
+            copies only the shared nodes on its path (O(log n)) so the other copies never see it.
+            copies may be used from different threads, one tree object may not
+                                                                        */
+
 template<class T>
 class BinarySearchTree {
     struct Node;
+    // nullptr while the tree is empty
     Node *head;
 
+    static constexpr int DELTA = 3;
+    static constexpr int RATIO = 2;
+    // smaller steps are not worth a thread
+    static constexpr int GRAIN = 4096;
+
 
 public:
-    BinarySearchTree() : head(new Node()) {
+    BinarySearchTree() : head(nullptr) {
     }
 
     ~BinarySearchTree() {
-        delete head;
+        release(head);
     }
 
     class const_iterator;
 
 
-    const_iterator begin() const {
-        return head;
-    }
+    // positioned at the minimum - O(h)
+    const_iterator begin() const;
 
     static const_iterator end() {
-        return nullptr;
+        return const_iterator();
     }
 
-    BinarySearchTree(const BinarySearchTree &other);
+    // a snapshot - shares every node with other, O(1)
+    BinarySearchTree(const BinarySearchTree &other) : head(retain(other.head)) {
+    }
+
+    BinarySearchTree(BinarySearchTree &&other) noexcept : head(other.head) {
+        other.head = nullptr;
+    }
 
     BinarySearchTree &operator =(const BinarySearchTree &other);
 
+    BinarySearchTree &operator =(BinarySearchTree &&other) noexcept {
+        std::swap(head, other.head);
+        return *this;
+    }
+
     void insert(const T &data) {
-        if (head->data) {
-            //not the first node
-            insertNode(data, head);
-        } else {
-            //inserting the first node
-            head = new Node(new T(data));
-        }
+        insertNode(data, head);
     }
 
 
@@ -62,7 +89,7 @@ public:
         if (!head) {
             throw EmptyTreeException{};
         }
-        return getMax(head);
+        return *rightmost(head)->data;
     }
 
     const T &getMinValue() const {
@@ -70,46 +97,169 @@ public:
             throw EmptyTreeException{};
         }
 
-        return getMin(head);
+        return *leftmost(head)->data;
     }
 
     void remove(const T &data);
 
     void remove(const T &data, Node *&node);
 
+    // end() if data is not in the set - O(h)
+    const_iterator find(const T &data) const;
+
+    bool contains(const T &data) const {
+        return lookup(head, data) != nullptr;
+    }
+
+    // first item not less than data - O(h)
+    const_iterator lowerBound(const T &data) const;
+
+    // first item greater than data - O(h)
+    const_iterator upperBound(const T &data) const;
+
+    class Range;
+
+    // the items in [lo, hi) in order - only the matching part of the tree is walked
+    Range range(const T &lo, const T &hi) const;
+
+    // how many items are in [lo, hi) - O(h) through the subtree sizes
+    int countRange(const T &lo, const T &hi) const {
+        int count = rank(hi) - rank(lo);
+        return count > 0 ? count : 0;
+    }
+
+    int getSize() const {
+        return head ? head->size : 0;
+    }
+
+    // set algebra - O(m log(n / m + 1)) for sets of m <= n items, split over threads past GRAIN.
+    // the nodes of an rvalue that nothing else shares are reused instead of copied
+
+    BinarySearchTree setUnion(BinarySearchTree other) const & {
+        return BinarySearchTree(*this).setUnion(std::move(other));
+    }
+
+    BinarySearchTree setUnion(BinarySearchTree other) && {
+        return combine(other, &BinarySearchTree::unite);
+    }
+
+    BinarySearchTree setIntersection(BinarySearchTree other) const & {
+        return BinarySearchTree(*this).setIntersection(std::move(other));
+    }
+
+    BinarySearchTree setIntersection(BinarySearchTree other) && {
+        return combine(other, &BinarySearchTree::intersect);
+    }
+
+    // the items of this set that are not in other
+    BinarySearchTree setDifference(BinarySearchTree other) const & {
+        return BinarySearchTree(*this).setDifference(std::move(other));
+    }
+
+    BinarySearchTree setDifference(BinarySearchTree other) && {
+        return combine(other, &BinarySearchTree::subtract);
+    }
+
     void traversal() const {
 
-        if (!head->data) {
+        if (!head) {
             return;
         }
-        inOrderTraversal(head);
+        inOrderTraversal();
         std::cout << std::endl;
     }
 
 
 private:
-    static void insertCurrent(Node *here, Node *that);
+    // one more link to node, returns node
+    static Node *retain(Node *node);
 
-    void insertNode(const T &data, Node *node);
+    // drops a link to node, the subtree goes with the last one
+    static void release(Node *node);
 
-    void inOrderTraversal(Node *node) const;
+    static void release(std::initializer_list<Node *> nodes) {
+        for (Node *node : nodes) {
+            release(node);
+        }
+    }
 
-    const T &getMax(Node *node) const {
+    // node itself if this is its only link, otherwise a private copy that takes over the link.
+    // if the copy throws the link still holds node
+    static Node *unshare(Node *node);
 
-        if (node->right) {
-            return getMax(node->right);
-        }
+    // unshare() for a link the caller gives up - released if the copy throws
+    static Node *take(Node *node);
 
-        return *node->data;
-    }
+    // the node of data in the subtree, nullptr if there is none
+    static const Node *lookup(const Node *node, const T &data);
+
+    void insertNode(const T &data, Node *&node);
+
+    // recounts the (unshared) nodes of path, the child of each one next, then rebalances
+    // them from the bottom - a rotation that cannot copy leaves a valid, less balanced tree
+    static void rebalancePath(Node *&root, const std::vector<Node *> &path);
+
+    // sets the children of node and its size, returns node
+    static Node *attach(Node *node, Node *left, Node *right);
+
+    // unshared node with its children rebalanced by at most one (double) rotation, returns the
+    // new root. the rotated children are unshared first, so a throw changes nothing
+    static Node *balance(Node *node);
+
+    // balance() of a subtree the caller gives up - released if it throws
+    static Node *rebalance(Node *node);
+
+    static Node *rotateLeft(Node *node);
+
+    static Node *rotateRight(Node *node);
 
-    const T &getMin(Node *node) const {
+    // the functions below take over every link passed to them and release them all if they throw
 
-        if (node->left) {
-            return getMin(node->left);
+    // join - one tree of left, node and right (every item of left < node < every item of right).
+    // node must be unshared and have no children
+    static Node *link(Node *left, Node *node, Node *right);
+
+    // join without a middle node
+    static Node *merge(Node *left, Node *right);
+
+    // unlinks the smallest node of the subtree into min, returns what is left
+    static Node *removeMin(Node *node, Node *&min);
+
+    static Node *removeMax(Node *node, Node *&max);
+
+    // splits node into the items less than and greater than data, true if data was in it
+    static bool split(Node *node, const T &data, Node *&less, Node *&greater);
+
+    // the set operations take both trees apart, forks is how many threads they may still use
+    static Node *unite(Node *a, Node *b, unsigned forks);
+
+    static Node *intersect(Node *a, Node *b, unsigned forks);
+
+    static Node *subtract(Node *a, Node *b, unsigned forks);
+
+    // runs first on another thread and second on this one when forks allow it
+    template<class First, class Second>
+    static void fork(unsigned forks, int size, First first, Second second);
+
+    BinarySearchTree combine(BinarySearchTree &other, Node *(*op)(Node *, Node *, unsigned));
+
+    void inOrderTraversal() const;
+
+    // how many items are less than data
+    int rank(const T &data) const;
+
+    static Node *leftmost(Node *node) {
+        while (node->left) {
+            node = node->left;
         }
+        return node;
+    }
 
-        return *node->data;
+    static Node *rightmost(Node *node) {
+        while (node->right) {
+            node = node->right;
+        }
+        return node;
     }
 
 };
@@ -121,16 +271,24 @@ struct BinarySearchTree<T>::Node {
     T *data;
     Node *left;
     Node *right;
+    // items in the subtree rooted here
+    int size;
+    // links to this node (a head or a child link) - with more than one it is never changed
+    std::atomic<int> refs;
 
-    explicit Node(T *_data = nullptr) : data(_data), left(nullptr), right(nullptr) {};
+    explicit Node(T *_data = nullptr, Node *_left = nullptr, Node *_right = nullptr)
+            : data(_data), left(_left), right(_right), size(sizeOf(_left) + sizeOf(_right) + 1), refs(1) {};
+
+    static int sizeOf(const Node *node) {
+        return node ? node->size : 0;
+    }
 
-    Node(const Node &other) = default;
+    Node(const Node &other) = delete;
 
-    Node &operator=(const Node &other) = default;
+    Node &operator=(const Node &other) = delete;
 
+    // the children are released by the tree (see release) - they may be shared
     ~Node() {
-        delete left;
-        delete right;
         delete data;
     }
 
@@ -142,63 +300,22 @@ template<class T>
 class BinarySearchTree<T>::const_iterator {
     friend class BinarySearchTree<T>;
 
-    Node *p;
-    Node *iterator;
-    bool isHead = false;
-    // std::vector<Node *> in_order; much nicer to use vector.
+    // the current node on top, below it the ancestors still to visit (those we went left from).
+    // no parent pointers - a shared node has more than one parent
+    std::vector<const Node *> pending;
 
 private:
-    const_iterator(Node *pt = nullptr) : p(pt) {}
+    const_iterator() = default;
 
-
-// more elegant but O(n)
-/*    void searchNext(Node *iter, Node *curr) {
-        if (iter->left) {
-            searchNext(iter->left, curr);
-        }
-        if (*curr->data < *iter->data) {
-            if (p->data == curr->data) {
-                p = iter;
-                return;
-            }
-            return;
-        }
-        if (iter->right) {
-            searchNext(iter->right, curr);
-        }
-    }*/
-
-    // (log(N))
-    void searchNext(Node *iter, Node *curr) {
-        if (*curr->data < *iter->data) {
-            if (iter->left) {
-                searchNext(iter->left, curr);
-            }
-            if (p->data == curr->data && *iter->data > *curr->data) {
-                p = iter;
-            }
-        } else if (*iter->data < *curr->data) {
-            if (iter->right) {
-                searchNext(iter->right, curr);
-            }
-        }
-        // equal!!!
-        if (iter->right) {
-            searchNext(iter->right, curr);
-            if (*curr->data < *iter->data) {
-                if (p->data == curr->data) {
-                    p = iter;
-                }
-            }
+    // node and the smallest items of its subtree on top of the pending ones
+    void descend(const Node *node) {
+        for (; node; node = node->left) {
+            pending.push_back(node);
         }
     }
 
-
-    static T *getMaxValue(Node *iter) {
-        while (iter->right) {
-            iter = iter->right;
-        }
-        return iter->data;
+    const Node *current() const {
+        return pending.empty() ? nullptr : pending.back();
     }
 
 public:
@@ -206,179 +323,235 @@ public:
 
     const_iterator &operator=(const const_iterator &iter) = default;
 
-    int operator!=(const const_iterator itr) const {
-        return (p != itr.p && p->data != nullptr);
+    int operator!=(const const_iterator &itr) const {
+        return (current() != itr.current());
     }
 
-    int operator==(const const_iterator itr) const {
-        return (p == itr.p);
+    int operator==(const const_iterator &itr) const {
+        return (current() == itr.current());
     }
 
-    const T &operator*() {
-        if (p == nullptr || p->data == nullptr) {
+    const T &operator*() const {
+        if (pending.empty()) {
             throw std::out_of_range("");
         }
-        // want to set iterator as a root
-        if (!isHead) {
-            iterator = p;
-            // set begin to min value
-            while (p->left) {
-                p = p->left;
-            }
-            isHead = true;
-        }
-        return *(p->data);
+        return *(pending.back()->data);
     }
 
 
-    const_iterator operator++() {
-        if (p == nullptr) {
+    // amortized O(1) - a full scan pushes and pops every node once
+    const_iterator &operator++() {
+        if (pending.empty()) {
             throw std::out_of_range("");
         }
-        if (p->data == getMaxValue(iterator)) {
-            p = nullptr;
-            return p;
-        }
-        searchNext(iterator, p);
-        return p;
+        const Node *node = pending.back();
+        pending.pop_back();
+        // the next item is the smallest one of the right subtree, or else the nearest pending ancestor
+        descend(node->right);
+        return *this;
     }
 
 };
 
 
 template<class T>
-void BinarySearchTree<T>::insertCurrent(BinarySearchTree::Node *here, BinarySearchTree::Node *that) {
-    if (that->left && that->left->data) {
-        here->left = new Node(new T(*(that->left->data)));
-        insertCurrent(here->left, that->left);
+class BinarySearchTree<T>::Range {
+    friend class BinarySearchTree<T>;
+
+    const_iterator first;
+    const_iterator last;
+
+    Range(const_iterator _first, const_iterator _last) : first(std::move(_first)), last(std::move(_last)) {}
+
+public:
+    const_iterator begin() const {
+        return first;
     }
-    if (that->right && that->right->data) {
-        here->right = new Node(new T(*(that->right->data)));
-        insertCurrent(here->right, that->right);
+
+    const_iterator end() const {
+        return last;
+    }
+};
+
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::retain(BinarySearchTree::Node *node) {
+    if (node) {
+        node->refs.fetch_add(1, std::memory_order_relaxed);
     }
+    return node;
 }
 
 template<class T>
-BinarySearchTree<T>::BinarySearchTree(const BinarySearchTree &other):head(other.head->data == nullptr ?
-                                                                          new Node() : new Node(
-                new T(*(other.head->data)))) {
-    insertCurrent(head, other.head);
+void BinarySearchTree<T>::release(BinarySearchTree::Node *node) {
+    // recursion on the left only, the tree is balanced so it stays O(log n) deep
+    while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        Node *right = node->right;
+        release(node->left);
+        delete node;
+        node = right;
+    }
 }
 
 template<class T>
-void BinarySearchTree<T>::insertNode(const T &data, BinarySearchTree::Node *node) {
-    //if the data is smaller: we go to the left
-    if (data < *node->data) {
-        //let's find the location recursively where to insert
-        if (node->left) {
-            insertNode(data, node->left);
-        } else {
-            //no left node: this is the location where we have to insert
-            node->left = new Node(new T(data));
-        }
-    } else if (*node->data < data) {
-        //else we have to go to the right subtree and find the location
-        if (node->right) {
-            insertNode(data, node->right);
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::unshare(BinarySearchTree::Node *node) {
+    if (node->refs.load(std::memory_order_acquire) == 1) {
+        return node;
+    }
+    T *data = new T(*node->data);
+    Node *copy;
+    try {
+        // the children stay shared, only this node is copied
+        copy = new Node(data, retain(node->left), retain(node->right));
+    } catch (...) {
+        delete data;
+        throw;
+    }
+    release(node);
+    return copy;
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::take(BinarySearchTree::Node *node) {
+    try {
+        return unshare(node);
+    } catch (...) {
+        release(node);
+        throw;
+    }
+}
+
+template<class T>
+const typename BinarySearchTree<T>::Node *BinarySearchTree<T>::lookup(const BinarySearchTree::Node *node,
+                                                                      const T &data) {
+    while (node) {
+        if (data < *node->data) {
+            node = node->left;
+        } else if (*node->data < data) {
+            node = node->right;
         } else {
-            //no right node: so this is where to insert
-            node->right = new Node(new T(data));
+            return node;
         }
     }
+    return nullptr;
 }
 
-//the only function with O(N) every single time.
 template<class T>
-void BinarySearchTree<T>::inOrderTraversal(BinarySearchTree::Node *node) const {
-    if (node->left) {
-        inOrderTraversal(node->left);
-    }
-    std::cout << *node->data << " ";
+typename BinarySearchTree<T>::const_iterator BinarySearchTree<T>::begin() const {
+    const_iterator it;
+    it.descend(head);
+    return it;
+}
 
-    if (node->right) {
-        inOrderTraversal(node->right);
+template<class T>
+void BinarySearchTree<T>::insertNode(const T &data, Node *&node) {
+    // already in the set - nothing to copy
+    if (lookup(node, data)) {
+        return;
+    }
+    std::vector<Node *> path;
+    Node **slot = &node;
+    while (*slot) {
+        // a snapshot keeps the old node, we go on with our own
+        *slot = unshare(*slot);
+        Node *current = *slot;
+        path.push_back(current);
+        //if the data is smaller: we go to the left
+        //else we have to go to the right subtree and find the location
+        slot = data < *current->data ? &current->left : &current->right;
     }
+    //no child here: this is the location where we have to insert
+    *slot = new Node(new T(data));
+    // every subtree on the way down grew by one
+    rebalancePath(node, path);
+}
 
+//the only function with O(N) every single time.
+template<class T>
+void BinarySearchTree<T>::inOrderTraversal() const {
+    for (const_iterator it = begin(); it != end(); ++it) {
+        std::cout << *it << " ";
+    }
 }
 
 
 template<class T>
 BinarySearchTree<T> &BinarySearchTree<T>::operator=(const BinarySearchTree &other) {
-    if (&other == this) {
-        return *this;
-    }
-    Node *temp;
-    // must allocate first to avoid leak encase of failure allocation
-    other.head->data == nullptr ? temp = new Node() : temp = new Node(new T(*other.head->data));
-    insertCurrent(temp, other.head);
-    // now it safe to deallocate
-    delete head;
+    // retain first - other may be this or share our root
+    Node *temp = retain(other.head);
+    release(head);
     head = temp;
     return *this;
 }
 
 template<class T>
 void BinarySearchTree<T>::remove(const T &data, BinarySearchTree::Node *&node) {
-    //first we have to find the node we want to remove
-    if (data < *node->data) {
-        if (node->left)
-            remove(data, node->left);
-    } else if (data > *node->data) {
-        if (node->right)
-            remove(data, node->right);
-    } else {
+    //first we have to find the node we want to remove - without copying anything on the way
+    if (!lookup(node, data)) {
+        return;
+    }
 
-        // we have found the node we want to remove !!!
-        //removing a leaf node
-        if (!node->left && !node->right) {
-            std::cout << "Removing a leaf node...\n";
-            delete node;
-            node = nullptr;
-            return;
-        }
-        //removing a right child
-        if (!node->left) {
-            std::cout << "Removing the right child...\n";
-            Node *temp = node->right;
-            node->right = nullptr;
-            delete node;
-            node = temp;
-            return;
-            //removing a left child
-        } else if (!node->right) {
-            std::cout << "Removing the left child...\n";
-            Node *temp = node->left;
-            node->left = nullptr;
-            delete node;
-            node = temp;
-            return;
+    // now again, taking our own copy of every shared node on the path
+    std::vector<Node *> path;
+    Node **slot = &node;
+    while (true) {
+        *slot = unshare(*slot);
+        Node *current = *slot;
+        if (data < *current->data) {
+            slot = &current->left;
+        } else if (*current->data < data) {
+            slot = &current->right;
+        } else {
+            break;
         }
+        path.push_back(current);
+    }
 
+    // we have found the node we want to remove !!!
+    Node *target = *slot;
+    Node *replacement;
+    //removing a leaf node
+    if (!target->left && !target->right) {
+        std::cout << "Removing a leaf node...\n";
+        replacement = nullptr;
+        //removing a right child
+    } else if (!target->left) {
+        std::cout << "Removing the right child...\n";
+        replacement = target->right;
+        //removing a left child
+    } else if (!target->right) {
+        std::cout << "Removing the left child...\n";
+        replacement = target->left;
+    } else {
         // we remove a node with two children case !!!
         std::cout << "Removing item with two children...\n";
         //we find the largest item in the left subtree (or the smallest in the right subtree is valid as well)
-        //this is the PREDECESSOR
-        Node *temp = node->left;
-        Node *predecessor;
-        // means the predecessor is left leaf
-        if (!temp->right) {
-            predecessor = node->left;
-            predecessor->right = node->right;
-        } else {
-            while (temp->right && temp->right->right) {
-                temp = temp->right;
-            }
-            predecessor = temp->right;
-            temp->right = nullptr;
-            predecessor->right = node->right;
-            predecessor->left = node->left;
+        //this is the PREDECESSOR - it takes the place of target in the path
+        path.push_back(nullptr);
+        std::size_t place = path.size() - 1;
+        Node **predecessor_slot = &target->left;
+        *predecessor_slot = unshare(*predecessor_slot);
+        while ((*predecessor_slot)->right) {
+            path.push_back(*predecessor_slot);
+            predecessor_slot = &(*predecessor_slot)->right;
+            *predecessor_slot = unshare(*predecessor_slot);
         }
-
-        node->right = nullptr;
-        node->left = nullptr;
-        delete node;
-        node = predecessor;
+        // nothing throws from here on
+        Node *predecessor = *predecessor_slot;
+        // the predecessor's left subtree takes its place (also when it is the left child itself)
+        *predecessor_slot = predecessor->left;
+        predecessor->left = target->left;
+        predecessor->right = target->right;
+        path[place] = predecessor;
+        replacement = predecessor;
     }
+
+    // target gives its links to the replacement
+    target->left = nullptr;
+    target->right = nullptr;
+    *slot = replacement;
+    release(target);
+    rebalancePath(node, path);
 }
 
 template<class T>
@@ -389,4 +562,444 @@ void BinarySearchTree<T>::remove(const T &data) {
     remove(data, head);
 }
 
-#endif //SORTED_BST_BINARYSEARCHTREE_H
\ No newline at end of file
+template<class T>
+typename BinarySearchTree<T>::const_iterator BinarySearchTree<T>::find(const T &data) const {
+    const_iterator it;
+    const Node *node = head;
+    while (node) {
+        if (data < *node->data) {
+            it.pending.push_back(node);
+            node = node->left;
+        } else if (*node->data < data) {
+            node = node->right;
+        } else {
+            it.pending.push_back(node);
+            return it;
+        }
+    }
+    return end();
+}
+
+template<class T>
+typename BinarySearchTree<T>::const_iterator BinarySearchTree<T>::lowerBound(const T &data) const {
+    const_iterator it;
+    const Node *node = head;
+    while (node) {
+        if (*node->data < data) {
+            node = node->right;
+        } else {
+            // a candidate - a smaller one can only be on the left
+            it.pending.push_back(node);
+            node = node->left;
+        }
+    }
+    return it;
+}
+
+template<class T>
+typename BinarySearchTree<T>::const_iterator BinarySearchTree<T>::upperBound(const T &data) const {
+    const_iterator it;
+    const Node *node = head;
+    while (node) {
+        if (data < *node->data) {
+            it.pending.push_back(node);
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    return it;
+}
+
+template<class T>
+typename BinarySearchTree<T>::Range BinarySearchTree<T>::range(const T &lo, const T &hi) const {
+    if (!(lo < hi)) {
+        return Range(end(), end());
+    }
+    return Range(lowerBound(lo), lowerBound(hi));
+}
+
+template<class T>
+int BinarySearchTree<T>::rank(const T &data) const {
+    int count = 0;
+    const Node *node = head;
+    while (node) {
+        if (*node->data < data) {
+            // the node and its whole left subtree are smaller
+            count += Node::sizeOf(node->left) + 1;
+            node = node->right;
+        } else {
+            node = node->left;
+        }
+    }
+    return count;
+}
+
+template<class T>
+void BinarySearchTree<T>::rebalancePath(Node *&root, const std::vector<Node *> &path) {
+    // the sizes first, so they are right whatever happens to the rotations
+    for (std::size_t i = path.size(); i-- > 0;) {
+        path[i]->size = Node::sizeOf(path[i]->left) + Node::sizeOf(path[i]->right) + 1;
+    }
+    for (std::size_t i = path.size(); i-- > 0;) {
+        Node *parent = i ? path[i - 1] : nullptr;
+        Node *&slot = !parent ? root : (parent->left == path[i] ? parent->left : parent->right);
+        slot = balance(path[i]);
+    }
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::attach(BinarySearchTree::Node *node,
+                                                               BinarySearchTree::Node *left,
+                                                               BinarySearchTree::Node *right) {
+    node->left = left;
+    node->right = right;
+    node->size = Node::sizeOf(left) + Node::sizeOf(right) + 1;
+    return node;
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::balance(BinarySearchTree::Node *node) {
+    int left_size = Node::sizeOf(node->left);
+    int right_size = Node::sizeOf(node->right);
+    if (left_size + right_size > 1) {
+        if (right_size > DELTA * left_size) {
+            return rotateLeft(node);
+        }
+        if (left_size > DELTA * right_size) {
+            return rotateRight(node);
+        }
+    }
+    return attach(node, node->left, node->right);
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::rebalance(BinarySearchTree::Node *node) {
+    try {
+        return balance(node);
+    } catch (...) {
+        release(node);
+        throw;
+    }
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::rotateLeft(BinarySearchTree::Node *node) {
+    node->right = unshare(node->right);
+    Node *right = node->right;
+    // a single rotation would only move the weight of right->left over to node
+    if (Node::sizeOf(right->left) < RATIO * Node::sizeOf(right->right)) {
+        return attach(right, attach(node, node->left, right->left), right->right);
+    }
+    right->left = unshare(right->left);
+    Node *middle = right->left;
+    return attach(middle, attach(node, node->left, middle->left), attach(right, middle->right, right->right));
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::rotateRight(BinarySearchTree::Node *node) {
+    node->left = unshare(node->left);
+    Node *left = node->left;
+    if (Node::sizeOf(left->right) < RATIO * Node::sizeOf(left->left)) {
+        return attach(left, left->left, attach(node, left->right, node->right));
+    }
+    left->right = unshare(left->right);
+    Node *middle = left->right;
+    return attach(middle, attach(left, left->left, middle->left), attach(node, middle->right, node->right));
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::link(BinarySearchTree::Node *left,
+                                                             BinarySearchTree::Node *node,
+                                                             BinarySearchTree::Node *right) {
+    int left_size = Node::sizeOf(left);
+    int right_size = Node::sizeOf(right);
+    // walk down the spine of the heavier side until the two sides are comparable
+    if (left_size + right_size > 1 && DELTA * left_size < right_size) {
+        Node *heavy;
+        try {
+            heavy = take(right);
+        } catch (...) {
+            release({left, node});
+            throw;
+        }
+        Node *inner;
+        try {
+            inner = link(left, node, std::exchange(heavy->left, nullptr));
+        } catch (...) {
+            release(heavy);
+            throw;
+        }
+        attach(heavy, inner, heavy->right);
+        return rebalance(heavy);
+    }
+    if (left_size + right_size > 1 && DELTA * right_size < left_size) {
+        Node *heavy;
+        try {
+            heavy = take(left);
+        } catch (...) {
+            release({node, right});
+            throw;
+        }
+        Node *inner;
+        try {
+            inner = link(std::exchange(heavy->right, nullptr), node, right);
+        } catch (...) {
+            release(heavy);
+            throw;
+        }
+        attach(heavy, heavy->left, inner);
+        return rebalance(heavy);
+    }
+    return attach(node, left, right);
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::merge(BinarySearchTree::Node *left,
+                                                              BinarySearchTree::Node *right) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+    // the middle node comes out of the larger side
+    Node *middle;
+    try {
+        if (left->size > right->size) {
+            left = removeMax(std::exchange(left, nullptr), middle);
+        } else {
+            right = removeMin(std::exchange(right, nullptr), middle);
+        }
+    } catch (...) {
+        release({left, right});
+        throw;
+    }
+    return link(left, middle, right);
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::removeMin(BinarySearchTree::Node *node,
+                                                                  BinarySearchTree::Node *&min) {
+    node = take(node);
+    if (!node->left) {
+        Node *right = node->right;
+        min = attach(node, nullptr, nullptr);
+        return right;
+    }
+    Node *left;
+    try {
+        left = removeMin(std::exchange(node->left, nullptr), min);
+    } catch (...) {
+        release(node);
+        throw;
+    }
+    attach(node, left, node->right);
+    try {
+        return balance(node);
+    } catch (...) {
+        release({node, min});
+        throw;
+    }
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::removeMax(BinarySearchTree::Node *node,
+                                                                  BinarySearchTree::Node *&max) {
+    node = take(node);
+    if (!node->right) {
+        Node *left = node->left;
+        max = attach(node, nullptr, nullptr);
+        return left;
+    }
+    Node *right;
+    try {
+        right = removeMax(std::exchange(node->right, nullptr), max);
+    } catch (...) {
+        release(node);
+        throw;
+    }
+    attach(node, node->left, right);
+    try {
+        return balance(node);
+    } catch (...) {
+        release({node, max});
+        throw;
+    }
+}
+
+template<class T>
+bool BinarySearchTree<T>::split(BinarySearchTree::Node *node, const T &data,
+                                BinarySearchTree::Node *&less, BinarySearchTree::Node *&greater) {
+    // both stay nullptr if this throws
+    less = greater = nullptr;
+    if (!node) {
+        return false;
+    }
+    if (!(data < *node->data) && !(*node->data < data)) {
+        // the subtrees are kept as they are, node itself is not needed
+        less = retain(node->left);
+        greater = retain(node->right);
+        release(node);
+        return true;
+    }
+    node = take(node);
+    Node *left = std::exchange(node->left, nullptr);
+    Node *right = std::exchange(node->right, nullptr);
+    bool found;
+    Node *between;
+    if (data < *node->data) {
+        try {
+            found = split(left, data, less, between);
+        } catch (...) {
+            release({node, right});
+            throw;
+        }
+        try {
+            greater = link(between, node, right);
+        } catch (...) {
+            release(std::exchange(less, nullptr));
+            throw;
+        }
+    } else {
+        try {
+            found = split(right, data, between, greater);
+        } catch (...) {
+            release({node, left});
+            throw;
+        }
+        try {
+            less = link(left, node, between);
+        } catch (...) {
+            release(std::exchange(greater, nullptr));
+            throw;
+        }
+    }
+    return found;
+}
+
+template<class T>
+template<class First, class Second>
+void BinarySearchTree<T>::fork(unsigned forks, int size, First first, Second second) {
+    if (forks < 2 || size < GRAIN) {
+        first();
+        second();
+        return;
+    }
+    std::future<void> other = std::async(std::launch::async, first);
+    // if second throws, the future waits for first on its way out
+    second();
+    other.get();
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::unite(BinarySearchTree::Node *a,
+                                                              BinarySearchTree::Node *b, unsigned forks) {
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    // an item in both sets keeps the node of a
+    try {
+        a = take(a);
+    } catch (...) {
+        release(b);
+        throw;
+    }
+    Node *a_left = std::exchange(a->left, nullptr);
+    Node *a_right = std::exchange(a->right, nullptr);
+    Node *less = nullptr, *greater = nullptr;
+    Node *left = nullptr, *right = nullptr;
+    try {
+        split(b, *a->data, less, greater);
+        int size = a->size + Node::sizeOf(less) + Node::sizeOf(greater);
+        // each half takes its links, whatever is still here after a throw is ours to release
+        fork(forks, size,
+             [&] { left = unite(std::exchange(a_left, nullptr), std::exchange(less, nullptr), forks / 2); },
+             [&] { right = unite(std::exchange(a_right, nullptr), std::exchange(greater, nullptr),
+                                 forks - forks / 2); });
+    } catch (...) {
+        release({a, a_left, a_right, less, greater, left, right});
+        throw;
+    }
+    return link(left, a, right);
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::intersect(BinarySearchTree::Node *a,
+                                                                  BinarySearchTree::Node *b, unsigned forks) {
+    if (!a || !b) {
+        release({a, b});
+        return nullptr;
+    }
+    try {
+        a = take(a);
+    } catch (...) {
+        release(b);
+        throw;
+    }
+    Node *a_left = std::exchange(a->left, nullptr);
+    Node *a_right = std::exchange(a->right, nullptr);
+    Node *less = nullptr, *greater = nullptr;
+    Node *left = nullptr, *right = nullptr;
+    bool found;
+    try {
+        found = split(b, *a->data, less, greater);
+        int size = a->size + Node::sizeOf(less) + Node::sizeOf(greater);
+        fork(forks, size,
+             [&] { left = intersect(std::exchange(a_left, nullptr), std::exchange(less, nullptr), forks / 2); },
+             [&] { right = intersect(std::exchange(a_right, nullptr), std::exchange(greater, nullptr),
+                                     forks - forks / 2); });
+    } catch (...) {
+        release({a, a_left, a_right, less, greater, left, right});
+        throw;
+    }
+    if (found) {
+        return link(left, a, right);
+    }
+    release(a);
+    return merge(left, right);
+}
+
+template<class T>
+typename BinarySearchTree<T>::Node *BinarySearchTree<T>::subtract(BinarySearchTree::Node *a,
+                                                                 BinarySearchTree::Node *b, unsigned forks) {
+    if (!a || !b) {
+        release(b);
+        return a;
+    }
+    // b only lends its item and its subtrees
+    Node *b_left = retain(b->left);
+    Node *b_right = retain(b->right);
+    Node *less = nullptr, *greater = nullptr;
+    Node *left = nullptr, *right = nullptr;
+    try {
+        // the node of a with b's item is dropped
+        split(std::exchange(a, nullptr), *b->data, less, greater);
+        release(std::exchange(b, nullptr));
+        int size = Node::sizeOf(b_left) + Node::sizeOf(b_right) + Node::sizeOf(less) + Node::sizeOf(greater);
+        fork(forks, size,
+             [&] { left = subtract(std::exchange(less, nullptr), std::exchange(b_left, nullptr), forks / 2); },
+             [&] { right = subtract(std::exchange(greater, nullptr), std::exchange(b_right, nullptr),
+                                    forks - forks / 2); });
+    } catch (...) {
+        release({a, b, b_left, b_right, less, greater, left, right});
+        throw;
+    }
+    return merge(left, right);
+}
+
+template<class T>
+BinarySearchTree<T> BinarySearchTree<T>::combine(BinarySearchTree &other, Node *(*op)(Node *, Node *, unsigned)) {
+    // the operation takes over both roots
+    Node *a = std::exchange(head, nullptr);
+    Node *b = std::exchange(other.head, nullptr);
+    unsigned forks = std::thread::hardware_concurrency();
+    BinarySearchTree<T> result;
+    result.head = op(a, b, forks ? forks : 1);
+    return result;
+}
+
+#endif //SORTED_BST_BINARYSEARCHTREE_H
@@ -7,30 +7,93 @@
 
 #include <iostream>
 #include <exception>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /*
             My implementation for double sorted linked list
+            items also carry a tower of express lanes (skip list levels), level 0 is the
+            plain prev/next list so iteration is unchanged while insert and search are O(log n).
+            every link also stores its width (how many items it skips), which makes the
+            list indexable - at(k) and rank() follow the lanes like a search does
                                                                         */
 
 
 namespace mtm {
+    template<class Iterator, class Pred>
+    class FilterView;
+
+    template<class Iterator, class Func>
+    class MapView;
+
     template<class T>
     class SortedList {
     private:
         struct Item;
+
+        // levels of the express lanes, each one skips about 3 of every 4 items of the one below
+        static constexpr int MAX_LEVEL = 16;
+
         Item *head;
         Item *tail;
+        // highest level currently in use
+        int level;
+        unsigned long long seed;
+
+        int randomLevel();
+
+        // items[i] = last item at level i, ranks[i] = its position (the head is 0)
+        struct Lasts {
+            Item *items[MAX_LEVEL];
+            int ranks[MAX_LEVEL];
+        };
+
+        // update[i] = last item at level i whose data is not greater than data, ranks[i] = its position
+        void findPredecessors(const T &data, Item **update, int *ranks) const;
 
-        static void insertCurrent(const T &data, Item *here);
+        void linkAfter(Item *to_insert, Item **update, const int *ranks);
+
+        void lastItems(Lasts &lasts) const;
+
+        // links to_insert after the last item (O(1)), lasts is kept up to date
+        void appendItem(Item *to_insert, Lasts &lasts);
+
+        // appends an already sorted range, O(n)
+        template<class Iterator>
+        void appendSorted(Iterator first, Iterator last);
+
+        void swap(SortedList &other);
+
+        enum CombineOp {
+            MERGE, UNION, INTERSECTION, DIFFERENCE
+        };
+
+        // one pass over both lists, O(n + m) - with steal the items of this list are
+        // relinked into the result instead of copied, and this list is left empty
+        SortedList combine(const SortedList &other, CombineOp op, bool steal);
 
     public:
-        SortedList() : head(new Item), tail(new Item) {
-            head->next = tail;
+        SortedList() : head(new Item(nullptr, MAX_LEVEL)), tail(new Item), level(1), seed(0x9E3779B97F4A7C15ULL) {
+            for (int i = 0; i < MAX_LEVEL; ++i) {
+                head->link(i) = tail;
+                head->setWidth(i, 1);
+            }
             tail->prev = head;
         }
 
         ~SortedList() {
-            delete head;
+            // iteratively - a recursive ~Item overflows the stack on long lists
+            Item *it = head;
+            while (it) {
+                Item *next = it->next;
+                delete it;
+                it = next;
+            }
         }
 
         class const_iterator;
@@ -47,20 +110,97 @@ namespace mtm {
 
         SortedList(const SortedList &other_list);
 
+        // sorts the range once and links it in O(n), equal items keep their order
+        template<class Iterator>
+        SortedList(Iterator first, Iterator last);
+
         SortedList &operator=(const SortedList &other_list);
 
+        // O(1) expected - the top lane of the head spans the whole list
         int length() const;
 
+        // the k-th item (from 0) - O(log n) expected
+        const T &at(int k) const;
+
+        // how many items are less than data - O(log n) expected
+        int rank(const T &data) const;
+
+        // nearest rank percentile, p between 0 and 1 (0.99 for p99) - O(log n) expected
+        const T &percentile(double p) const;
+
+        // O(log n) expected
         void insert(const T &data);
 
+        // O(log n) expected
         void remove(const_iterator iter) const;
 
+        // first item not less than data - O(log n) expected
+        const_iterator lowerBound(const T &data) const;
+
+        // end() if data is not in the list - O(log n) expected
+        const_iterator find(const T &data) const;
+
+        // O(n log n) - the results are sorted once
         template<class Func>
         SortedList<T> apply(Func &f) const;
 
+        // O(n) - f must be non-decreasing, so the results are already in order
+        template<class Func>
+        SortedList<T> applyMonotone(Func &f) const;
+
+        // O(n) - the kept items are already in order
         template<class Bool>
         SortedList<T> filter(Bool &f) const;
 
+        // linear set algebra - O(n + m), equal items count as a multiset (like std::set_union).
+        // when the list on the left is an rvalue its items are moved into the result
+        // instead of copied, the moved-from list is left empty
+
+        // every item of both lists, on ties the items of this list come first
+        SortedList merge(const SortedList &other) const & {
+            return const_cast<SortedList *>(this)->combine(other, MERGE, false);
+        }
+
+        SortedList merge(const SortedList &other) && {
+            return combine(other, MERGE, true);
+        }
+
+        SortedList setUnion(const SortedList &other) const & {
+            return const_cast<SortedList *>(this)->combine(other, UNION, false);
+        }
+
+        SortedList setUnion(const SortedList &other) && {
+            return combine(other, UNION, true);
+        }
+
+        SortedList setIntersection(const SortedList &other) const & {
+            return const_cast<SortedList *>(this)->combine(other, INTERSECTION, false);
+        }
+
+        SortedList setIntersection(const SortedList &other) && {
+            return combine(other, INTERSECTION, true);
+        }
+
+        SortedList setDifference(const SortedList &other) const & {
+            return const_cast<SortedList *>(this)->combine(other, DIFFERENCE, false);
+        }
+
+        SortedList setDifference(const SortedList &other) && {
+            return combine(other, DIFFERENCE, true);
+        }
+
+        // lazy views over the items of this list - nothing is copied until materialize(),
+        // the list must outlive the view
+        template<class Bool>
+        FilterView<const_iterator, Bool> filtered(Bool f) const {
+            return FilterView<const_iterator, Bool>(begin(), end(), f);
+        }
+
+        template<class Func>
+        MapView<const_iterator, Func> mapped(Func f) const {
+            return MapView<const_iterator, Func>(begin(), end(), f);
+        }
+
 
     };
 
@@ -70,16 +210,42 @@ namespace mtm {
         Item *next;
         Item *prev;
         T *_data;
+        int height;
+
+        // a lane skips width items of the level 0 list (the last one it skips is link)
+        struct Lane {
+            Item *link;
+            int width;
+        };
+        // above[i - 1] is the lane at level i, level 0 is next and always has width 1
+        Lane *above;
 
-        explicit Item(T *data = nullptr) : _data(data), next(nullptr), prev(nullptr) {}
+        explicit Item(T *data = nullptr, int _height = 1) : next(nullptr), prev(nullptr), _data(data),
+                                                           height(_height),
+                                                           above(_height > 1 ? new Lane[_height - 1]() : nullptr) {}
 
-        Item(const Item &a) = default;
+        Item(const Item &a) = delete;
 
-        Item &operator=(const Item &a) = default;
+        Item &operator=(const Item &a) = delete;
 
+        // the list frees the chain item by item
         ~Item() {
             delete _data;
-            delete next;
+            delete[] above;
+        }
+
+        Item *&link(int lvl) {
+            return lvl == 0 ? next : above[lvl - 1].link;
+        }
+
+        int width(int lvl) const {
+            return lvl == 0 ? 1 : above[lvl - 1].width;
+        }
+
+        void setWidth(int lvl, int width) {
+            if (lvl > 0) {
+                above[lvl - 1].width = width;
+            }
         }
     };
 
@@ -124,24 +290,214 @@ namespace mtm {
     };
 
     template<class T>
-    void SortedList<T>::insertCurrent(const T &data, SortedList::Item *here) {
-        Item *to_insert = new Item(new T(data));
-        to_insert->next = here;
-        to_insert->prev = here->prev;
-        here->prev->next = to_insert;
-        here->prev = to_insert;
+    int SortedList<T>::randomLevel() {
+        // xorshift64*
+        seed ^= seed >> 12;
+        seed ^= seed << 25;
+        seed ^= seed >> 27;
+        unsigned long long bits = seed * 0x2545F4914F6CDD1DULL;
+        int height = 1;
+        while (height < MAX_LEVEL && (bits & 3) == 0) {
+            ++height;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    template<class T>
+    void SortedList<T>::findPredecessors(const T &data, SortedList::Item **update, int *ranks) const {
+        Item *x = head;
+        int pos = 0;
+        for (int i = level - 1; i >= 0; --i) {
+            // equal items are passed so a new one goes after them, like the linear insert did
+            while (x->link(i) != tail && !(data < *x->link(i)->_data)) {
+                pos += x->width(i);
+                x = x->link(i);
+            }
+            update[i] = x;
+            ranks[i] = pos;
+        }
+        for (int i = level; i < MAX_LEVEL; ++i) {
+            update[i] = head;
+            ranks[i] = 0;
+        }
+    }
+
+    template<class T>
+    void SortedList<T>::linkAfter(SortedList::Item *to_insert, SortedList::Item **update, const int *ranks) {
+        if (to_insert->height > level) {
+            level = to_insert->height;
+        }
+        int pos = ranks[0] + 1;
+        for (int i = 0; i < MAX_LEVEL; ++i) {
+            int width = update[i]->width(i);
+            if (i < to_insert->height) {
+                // the lane is split in two at to_insert
+                to_insert->link(i) = update[i]->link(i);
+                update[i]->link(i) = to_insert;
+                update[i]->setWidth(i, pos - ranks[i]);
+                to_insert->setWidth(i, ranks[i] + width + 1 - pos);
+            } else {
+                // the lane now skips over one more item
+                update[i]->setWidth(i, width + 1);
+            }
+        }
+        to_insert->prev = update[0];
+        to_insert->next->prev = to_insert;
+    }
+
+    template<class T>
+    void SortedList<T>::lastItems(Lasts &lasts) const {
+        Item *x = head;
+        int pos = 0;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x->link(i) != tail) {
+                pos += x->width(i);
+                x = x->link(i);
+            }
+            lasts.items[i] = x;
+            lasts.ranks[i] = pos;
+        }
+        for (int i = level; i < MAX_LEVEL; ++i) {
+            lasts.items[i] = head;
+            lasts.ranks[i] = 0;
+        }
+    }
+
+    template<class T>
+    void SortedList<T>::appendItem(SortedList::Item *to_insert, Lasts &lasts) {
+        if (to_insert->height > level) {
+            level = to_insert->height;
+        }
+        int pos = lasts.ranks[0] + 1;
+        for (int i = 0; i < MAX_LEVEL; ++i) {
+            Item *last = lasts.items[i];
+            if (i < to_insert->height) {
+                to_insert->link(i) = tail;
+                to_insert->setWidth(i, 1);
+                last->link(i) = to_insert;
+                last->setWidth(i, pos - lasts.ranks[i]);
+                lasts.items[i] = to_insert;
+                lasts.ranks[i] = pos;
+            } else {
+                // still reaches the tail, one item further away
+                last->setWidth(i, last->width(i) + 1);
+            }
+        }
+        to_insert->prev = tail->prev;
+        tail->prev = to_insert;
+    }
+
+    template<class T>
+    template<class Iterator>
+    void SortedList<T>::appendSorted(Iterator first, Iterator last) {
+        Lasts lasts;
+        lastItems(lasts);
+        for (; first != last; ++first) {
+            appendItem(new Item(new T(*first), randomLevel()), lasts);
+        }
+    }
+
+    template<class T>
+    SortedList<T> SortedList<T>::combine(const SortedList &other, CombineOp op, bool steal) {
+        if (steal && &other == this) {
+            // the items we relink would be pulled out from under the other side
+            SortedList<T> copy(other);
+            return combine(copy, op, true);
+        }
+
+        SortedList<T> result;
+        Lasts lasts;
+        result.lastItems(lasts);
+
+        // a: item of this list (taken or dropped), b: item of other (only ever copied)
+        auto take = [&](Item *a) {
+            if (steal) {
+                // the tower comes along - appendItem relinks (and re-measures) every level it has
+                result.appendItem(a, lasts);
+            } else {
+                result.appendItem(new Item(new T(*a->_data), result.randomLevel()), lasts);
+            }
+        };
+        auto drop = [&](Item *a) {
+            if (steal) {
+                delete a;
+            }
+        };
+        auto copy = [&](Item *b) {
+            result.appendItem(new Item(new T(*b->_data), result.randomLevel()), lasts);
+        };
+
+        Item *a = head->next;
+        Item *b = other.head->next;
+        while (a != tail && b != other.tail) {
+            // read next first - take/drop may relink or free a
+            Item *a_next = a->next;
+            if (*a->_data < *b->_data) {
+                op == INTERSECTION ? drop(a) : take(a);
+                a = a_next;
+            } else if (*b->_data < *a->_data) {
+                if (op == MERGE || op == UNION) {
+                    copy(b);
+                }
+                b = b->next;
+            } else {
+                op == DIFFERENCE ? drop(a) : take(a);
+                a = a_next;
+                // merge keeps b for the next round, the others consume one b per matched a
+                if (op != MERGE) {
+                    b = b->next;
+                }
+            }
+        }
+        while (a != tail) {
+            Item *a_next = a->next;
+            op == INTERSECTION ? drop(a) : take(a);
+            a = a_next;
+        }
+        while (b != other.tail && (op == MERGE || op == UNION)) {
+            copy(b);
+            b = b->next;
+        }
+
+        if (steal) {
+            // every item was relinked or freed - reset to an empty list
+            for (int i = 0; i < MAX_LEVEL; ++i) {
+                head->link(i) = tail;
+                head->setWidth(i, 1);
+            }
+            tail->prev = head;
+            level = 1;
+        }
+        return result;
+    }
+
+    template<class T>
+    void SortedList<T>::swap(SortedList &other) {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(level, other.level);
+        std::swap(seed, other.seed);
+    }
+
+    template<class T>
+    SortedList<T>::SortedList(const SortedList &other_list) : SortedList() {
+        // already in order - append each copy at the end
+        appendSorted(other_list.begin(), other_list.end());
     }
 
     template<class T>
-    SortedList<T>::SortedList(const SortedList &other_list) :
-            head(new Item), tail(new Item) {
-        head->next = tail;
-        tail->prev = head;
-        const_iterator done = other_list.end();
-        const_iterator it = other_list.begin();
-        for (it != done; ++it) {
-            insertCurrent((*it), tail);
+    template<class Iterator>
+    SortedList<T>::SortedList(Iterator first, Iterator last) : SortedList() {
+        std::vector<T> items;
+        for (; first != last; ++first) {
+            items.push_back(*first);
+        }
+        // already sorted input (a filtered view, another list) skips the sort
+        if (!std::is_sorted(items.begin(), items.end())) {
+            std::stable_sort(items.begin(), items.end());
         }
+        appendSorted(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
     }
 
     template<class T>
@@ -150,62 +506,174 @@ namespace mtm {
         if (this == &other_list) {
             return *this;
         }
-        auto *a = new SortedList<T>;
-        delete this->head; // must try allocate first to avoid leak possibility encase of exception
-        head = a->head;
-        tail = a->tail;
-        const_iterator done = other_list.end();
-        const_iterator it = other_list.begin();
-        for (it != done; ++it) {
-            insertCurrent((*it), tail);
-        }
+        // must copy first to avoid leak possibility encase of exception
+        SortedList<T> copy(other_list);
+        swap(copy);
         return *this;
     }
 
     template<class T>
     int SortedList<T>::length() const {
-        int size = 0;
-        const_iterator done = end();
-        const_iterator it = begin();
+        // only an item of the full height (about 1 in 4^15) splits the top lane
+        int span = 0;
+        for (Item *x = head; x != tail; x = x->link(MAX_LEVEL - 1)) {
+            span += x->width(MAX_LEVEL - 1);
+        }
+        // the last lane also counts the step onto the tail
+        return span - 1;
+    }
+
+    template<class T>
+    const T &SortedList<T>::at(int k) const {
+        if (k < 0 || k >= length()) {
+            throw std::out_of_range("SortedList index out of range");
+        }
+        // position of the item we want, the head is 0
+        int target = k + 1;
+        Item *x = head;
+        int pos = 0;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x->link(i) != tail && pos + x->width(i) <= target) {
+                pos += x->width(i);
+                x = x->link(i);
+            }
+        }
+        return *x->_data;
+    }
+
+    template<class T>
+    int SortedList<T>::rank(const T &data) const {
+        Item *x = head;
+        int pos = 0;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x->link(i) != tail && *x->link(i)->_data < data) {
+                pos += x->width(i);
+                x = x->link(i);
+            }
+        }
+        return pos;
+    }
 
-        for (it; it != done; ++it) {
-            ++size;
+    template<class T>
+    const T &SortedList<T>::percentile(double p) const {
+        if (!(p >= 0 && p <= 1)) {
+            throw std::invalid_argument("percentile must be between 0 and 1");
+        }
+        int n = length();
+        if (n == 0) {
+            throw std::out_of_range("SortedList is empty");
         }
-        return size;
+        // the smallest item with at least p of the list at or below it
+        int k = (int) std::ceil(p * n) - 1;
+        return at(k < 0 ? 0 : k);
     }
 
     template<class T>
     void SortedList<T>::insert(const T &data) {
-        const_iterator done = end();
-        const_iterator it = begin();
+        Item *update[MAX_LEVEL];
+        int ranks[MAX_LEVEL];
+        findPredecessors(data, update, ranks);
+        linkAfter(new Item(new T(data), randomLevel()), update, ranks);
+    }
+
+    template<class T>
+    void SortedList<T>::remove(const SortedList::const_iterator iter) const {
+        Item *target = iter.p;
+        if (target == nullptr || target->_data == nullptr) {
+            throw std::out_of_range("");
+        }
+
+        // descend to the last item smaller than target on every level
+        Item *update[MAX_LEVEL];
+        int ranks[MAX_LEVEL];
+        Item *x = head;
+        int pos = 0;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x->link(i) != tail && *x->link(i)->_data < *target->_data) {
+                pos += x->width(i);
+                x = x->link(i);
+            }
+            update[i] = x;
+            ranks[i] = pos;
+        }
+        for (int i = level; i < MAX_LEVEL; ++i) {
+            update[i] = head;
+            ranks[i] = 0;
+        }
 
-        for (it != done; ++it) {
-            if (data < (*it)) {
-                insertCurrent(data, (it.p));
-                return;
+        // only items equal to target can sit between x and target
+        int target_pos = pos + 1;
+        for (Item *it = x->next; it != target; it = it->next) {
+            if (it == tail) {
+                throw std::out_of_range("");
             }
+            ++target_pos;
+        }
 
+        for (int i = 0; i < MAX_LEVEL; ++i) {
+            Item *pred = update[i];
+            int pred_pos = ranks[i];
+            while (pred->link(i) != tail && pred_pos + pred->width(i) < target_pos) {
+                pred_pos += pred->width(i);
+                pred = pred->link(i);
+            }
+            if (pred->link(i) == target) {
+                pred->link(i) = target->link(i);
+                pred->setWidth(i, pred->width(i) + target->width(i) - 1);
+            } else {
+                // the lane jumps over target
+                pred->setWidth(i, pred->width(i) - 1);
+            }
         }
-        insertCurrent(data, it.p);
+
+        target->next->prev = target->prev;
+        delete target;
     }
 
     template<class T>
-    void SortedList<T>::remove(const SortedList::const_iterator iter) const {
-        Item *temp = iter.p->next;
-        iter.p->prev->next = temp;
-        temp->prev = iter.p->prev;
-        iter.p->next = nullptr;
-        delete iter.p;
+    typename SortedList<T>::const_iterator SortedList<T>::lowerBound(const T &data) const {
+        Item *x = head;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x->link(i) != tail && *x->link(i)->_data < data) {
+                x = x->link(i);
+            }
+        }
+        return const_iterator(x->next);
+    }
+
+    template<class T>
+    typename SortedList<T>::const_iterator SortedList<T>::find(const T &data) const {
+        const_iterator it = lowerBound(data);
+        if (it != end() && !(data < *it)) {
+            return it;
+        }
+        return end();
     }
 
     template<class T>
     template<class Func>
     SortedList<T> SortedList<T>::apply(Func &f) const {
+        std::vector<T> results;
         const_iterator done = end();
-        const_iterator it = begin();
+        for (const_iterator it = begin(); it != done; ++it) {
+            results.push_back(f(*it));
+        }
+        // stable - equal results keep their order, like inserting one by one did
+        std::stable_sort(results.begin(), results.end());
+        SortedList<T> new_list;
+        new_list.appendSorted(std::make_move_iterator(results.begin()), std::make_move_iterator(results.end()));
+        return new_list;
+    }
+
+    template<class T>
+    template<class Func>
+    SortedList<T> SortedList<T>::applyMonotone(Func &f) const {
         SortedList<T> new_list;
-        for (it; it != done; ++it) {
-            new_list.insert(f(*it));
+        Lasts lasts;
+        new_list.lastItems(lasts);
+        const_iterator done = end();
+        for (const_iterator it = begin(); it != done; ++it) {
+            new_list.appendItem(new Item(new T(f(*it)), new_list.randomLevel()), lasts);
         }
         return new_list;
     }
@@ -213,17 +681,157 @@ namespace mtm {
     template<class T>
     template<class Bool>
     SortedList<T> SortedList<T>::filter(Bool &f) const {
-        const_iterator done = end();
-        const_iterator it = begin();
         SortedList<T> new_list;
-        for (it; it != done; ++it) {
+        Lasts lasts;
+        new_list.lastItems(lasts);
+        const_iterator done = end();
+        for (const_iterator it = begin(); it != done; ++it) {
             if (f(*it)) {
-                new_list.insert(*it);
+                new_list.appendItem(new Item(new T(*it), new_list.randomLevel()), lasts);
             }
         }
         return new_list;
     }
 
 
+    /*
+            Lazy views over a SortedList (or over another view)
+            a view only holds a pair of iterators and the function, items are produced while
+            iterating so chaining views never copies or allocates
+                                                                        */
+
+    // what every view can do - View supplies begin(), end() and value_type
+    template<class View>
+    class LazyView {
+        const View &self() const {
+            return static_cast<const View &>(*this);
+        }
+
+    public:
+        // V only delays the lookup of View's members until View is complete
+        template<class Bool, class V = View>
+        FilterView<typename V::iterator, Bool> filtered(Bool f) const {
+            return FilterView<typename V::iterator, Bool>(self().begin(), self().end(), f);
+        }
+
+        template<class Func, class V = View>
+        MapView<typename V::iterator, Func> mapped(Func f) const {
+            return MapView<typename V::iterator, Func>(self().begin(), self().end(), f);
+        }
+
+        // the only step that allocates - builds a new sorted list out of the view
+        template<class V = View>
+        SortedList<typename V::value_type> materialize() const {
+            return SortedList<typename V::value_type>(self().begin(), self().end());
+        }
+    };
+
+    template<class Iterator, class Pred>
+    class FilterView : public LazyView<FilterView<Iterator, Pred>> {
+        Iterator first;
+        Iterator last;
+        Pred pred;
+
+    public:
+        typedef typename std::decay<decltype(*std::declval<Iterator>())>::type value_type;
+
+        class iterator {
+            friend class FilterView<Iterator, Pred>;
+
+            Iterator it;
+            Iterator last;
+            // a copy - the iterator must stay valid after a temporary view is gone
+            Pred pred;
+
+            iterator(Iterator _it, Iterator _last, const Pred &_pred) : it(_it), last(_last), pred(_pred) {
+                skip();
+            }
+
+            void skip() {
+                while (it != last && !pred(*it)) {
+                    ++it;
+                }
+            }
+
+        public:
+            bool operator!=(const iterator &itr) const {
+                return it != itr.it;
+            }
+
+            bool operator==(const iterator &itr) const {
+                return !(it != itr.it);
+            }
+
+            iterator &operator++() {
+                ++it;
+                skip();
+                return *this;
+            }
+
+            decltype(*std::declval<Iterator>()) operator*() const {
+                return *it;
+            }
+        };
+
+        FilterView(Iterator _first, Iterator _last, const Pred &_pred) : first(_first), last(_last), pred(_pred) {}
+
+        iterator begin() const {
+            return iterator(first, last, pred);
+        }
+
+        iterator end() const {
+            return iterator(last, last, pred);
+        }
+    };
+
+    template<class Iterator, class Func>
+    class MapView : public LazyView<MapView<Iterator, Func>> {
+        Iterator first;
+        Iterator last;
+        Func f;
+
+    public:
+        typedef typename std::decay<decltype(std::declval<Func &>()(*std::declval<Iterator>()))>::type value_type;
+
+        class iterator {
+            friend class MapView<Iterator, Func>;
+
+            Iterator it;
+            // a copy - the iterator must stay valid after a temporary view is gone
+            Func f;
+
+            iterator(Iterator _it, const Func &_f) : it(_it), f(_f) {}
+
+        public:
+            bool operator!=(const iterator &itr) const {
+                return it != itr.it;
+            }
+
+            bool operator==(const iterator &itr) const {
+                return !(it != itr.it);
+            }
+
+            iterator &operator++() {
+                ++it;
+                return *this;
+            }
+
+            // computed on every dereference
+            value_type operator*() const {
+                return f(*it);
+            }
+        };
+
+        MapView(Iterator _first, Iterator _last, const Func &_f) : first(_first), last(_last), f(_f) {}
+
+        iterator begin() const {
+            return iterator(first, f);
+        }
+
+        iterator end() const {
+            return iterator(last, f);
+        }
+    };
+
 }
 #endif //EX2_MTM_SORTEDLIST_H
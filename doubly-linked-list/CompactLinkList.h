@@ -0,0 +1,228 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_COMPACTLINKLIST_H
+#define DATA_STRUCTURES_COMPACTLINKLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+/*
+            Compact doubly linked list - same logic as LinkedList (./LinkList.h) but the nodes
+            live in one vector and link to each other through 32 bit indices.
+            freed slots are chained through their next index and reused first, so the list
+            is one contiguous block that can be moved or written out as is
+                                                                        */
+
+template<class T>
+class CompactLinkedList {
+public:
+    // stable handle of an item, valid until that item is removed
+    typedef std::uint32_t Index;
+
+    static constexpr Index NIL = std::numeric_limits<Index>::max();
+
+private:
+    struct Node;
+
+    std::vector<Node> nodes;
+    Index head;
+    Index tail;
+    // first free slot, the rest are chained through Node::next
+    Index free_head;
+    int size;
+
+public:
+
+    CompactLinkedList() : head(NIL), tail(NIL), free_head(NIL), size(0) {
+    }
+
+    class const_iterator;
+
+    const_iterator begin() const {
+        return const_iterator(this, head);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, NIL);
+    }
+
+    // O(1) amortized - links data at the end and returns its handle
+    Index insert(const T &data) {
+        Index index = allocate(data);
+        nodes[index].prev = tail;
+        // this is the first item in the list
+        if (tail == NIL) {
+            head = index;
+        } else {
+            nodes[tail].next = index;
+        }
+        tail = index;
+        return index;
+    }
+
+    // O(1) amortized - links data at the beginning and returns its handle
+    Index pushFront(const T &data) {
+        Index index = allocate(data);
+        nodes[index].next = head;
+        if (head == NIL) {
+            tail = index;
+        } else {
+            nodes[head].prev = index;
+        }
+        head = index;
+        return index;
+    }
+
+    // O(1) - the slot goes back on the free list
+    void remove(Index index) {
+        checkIndex(index);
+        Node &node = nodes[index];
+        if (node.prev != NIL) {
+            nodes[node.prev].next = node.next;
+        } else {
+            head = node.next;
+        }
+        if (node.next != NIL) {
+            nodes[node.next].prev = node.prev;
+        } else {
+            tail = node.prev;
+        }
+
+        // drop whatever resources the item holds, the slot itself stays
+        node.data = T();
+        node.in_use = false;
+        node.prev = NIL;
+        node.next = free_head;
+        free_head = index;
+        --size;
+    }
+
+    T &get(Index index) {
+        checkIndex(index);
+        return nodes[index].data;
+    }
+
+    const T &get(Index index) const {
+        checkIndex(index);
+        return nodes[index].data;
+    }
+
+    Index getHead() const {
+        return head;
+    }
+
+    Index getTail() const {
+        return tail;
+    }
+
+    Index getNext(Index index) const {
+        checkIndex(index);
+        return nodes[index].next;
+    }
+
+    Index getPrev(Index index) const {
+        checkIndex(index);
+        return nodes[index].prev;
+    }
+
+    void reserve(std::size_t capacity) {
+        nodes.reserve(capacity);
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    void traverse() const {
+        for (Index it = head; it != NIL; it = nodes[it].next) {
+            std::cout << "data: " << nodes[it].data << std::endl;
+        }
+    }
+
+private:
+    Index allocate(const T &data) {
+        Index index;
+        if (free_head != NIL) {
+            index = free_head;
+            free_head = nodes[index].next;
+            nodes[index].data = data;
+        } else {
+            if (nodes.size() >= NIL) {
+                throw std::length_error("CompactLinkedList is full.");
+            }
+            index = (Index) nodes.size();
+            nodes.push_back(Node(data));
+        }
+        nodes[index].in_use = true;
+        nodes[index].prev = NIL;
+        nodes[index].next = NIL;
+        ++size;
+        return index;
+    }
+
+    void checkIndex(Index index) const {
+        if (index >= nodes.size() || !nodes[index].in_use) {
+            throw std::out_of_range("Invalid list index.");
+        }
+    }
+};
+
+template<class T>
+struct CompactLinkedList<T>::Node {
+    T data;
+    Index prev;
+    Index next;
+    bool in_use;
+
+    explicit Node(const T &_data) : data(_data), prev(NIL), next(NIL), in_use(false) {}
+};
+
+template<class T>
+class CompactLinkedList<T>::const_iterator {
+    friend class CompactLinkedList<T>;
+
+    const CompactLinkedList<T> *list;
+    Index p;
+
+    const_iterator(const CompactLinkedList<T> *_list, Index pt) : list(_list), p(pt) {}
+
+public:
+    bool operator!=(const const_iterator &itr) const {
+        return p != itr.p;
+    }
+
+    bool operator==(const const_iterator &itr) const {
+        return p == itr.p;
+    }
+
+    const_iterator &operator++() {
+        if (p == NIL) {
+            throw std::out_of_range("");
+        }
+        p = list->nodes[p].next;
+        return *this;
+    }
+
+    const T &operator*() const {
+        if (p == NIL) {
+            throw std::out_of_range("");
+        }
+        return list->nodes[p].data;
+    }
+
+    Index index() const {
+        return p;
+    }
+};
+
+#endif //DATA_STRUCTURES_COMPACTLINKLIST_H
@@ -0,0 +1,196 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_INTRUSIVELIST_H
+#define DATA_STRUCTURES_INTRUSIVELIST_H
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include "LinkChain.h"
+
+/*
+            Intrusive doubly linked list - linked like LinkedList (./LinkList.h), both through
+            ./LinkChain.h, but the prev/next links live inside the user's object (a ListHook
+            member), so the list never allocates or copies and unlinking an object is O(1).
+            the list does not own the objects - they must outlive their membership
+
+            usage:  struct Job { int id; ListHook hook; };
+                    IntrusiveList<Job, &Job::hook> jobs;
+                                                                        */
+
+struct ListHook {
+    ListHook *prev;
+    ListHook *next;
+    // the object this hook is embedded in while it is linked, nullptr otherwise
+    void *owner;
+
+    ListHook() : prev(nullptr), next(nullptr), owner(nullptr) {}
+
+    // a copied object is not a member of the original's list
+    ListHook(const ListHook &) : ListHook() {}
+
+    ListHook &operator=(const ListHook &) {
+        return *this;
+    }
+
+    bool isLinked() const {
+        return owner != nullptr;
+    }
+
+    ListHook *getPrev() const {
+        return prev;
+    }
+
+    void setPrev(ListHook *_prev) {
+        prev = _prev;
+    }
+
+    ListHook *getNext() const {
+        return next;
+    }
+
+    void setNext(ListHook *_next) {
+        next = _next;
+    }
+};
+
+template<class T, ListHook T::*Hook>
+class IntrusiveList {
+    LinkChain<ListHook> links;
+
+public:
+
+    IntrusiveList() {
+    }
+
+    // only unlinks - the objects belong to the caller
+    ~IntrusiveList() {
+        clear();
+    }
+
+    IntrusiveList(const IntrusiveList &other) = delete;
+
+    IntrusiveList &operator=(const IntrusiveList &other) = delete;
+
+    class iterator;
+
+    iterator begin() const {
+        return iterator(links.head);
+    }
+
+    iterator end() const {
+        return iterator(nullptr);
+    }
+
+    // O(1) - links item at the end
+    void insert(T &item) {
+        links.linkBefore(nullptr, claim(item));
+    }
+
+    // O(1) - links item at the beginning
+    void pushFront(T &item) {
+        links.linkBefore(links.head, claim(item));
+    }
+
+    // O(1) - item must be a member of this list
+    void remove(T &item) {
+        ListHook *hook = &(item.*Hook);
+        if (!hook->isLinked()) {
+            return;
+        }
+        links.unlink(hook);
+        hook->owner = nullptr;
+    }
+
+    T &front() const {
+        if (!links.head) {
+            throw std::out_of_range("List is empty.");
+        }
+        return owner(links.head);
+    }
+
+    T &back() const {
+        if (!links.tail) {
+            throw std::out_of_range("List is empty.");
+        }
+        return owner(links.tail);
+    }
+
+    void clear() {
+        while (links.head) {
+            remove(owner(links.head));
+        }
+    }
+
+    bool isEmpty() const {
+        return links.size == 0;
+    }
+
+    int getSize() const {
+        return links.size;
+    }
+
+    void traverse() const {
+        for (ListHook *it = links.head; it; it = it->getNext()) {
+            std::cout << "data: " << owner(it) << std::endl;
+        }
+    }
+
+    // the object that embeds hook - hook must be linked
+    static T &owner(ListHook *hook) {
+        return *static_cast<T *>(hook->owner);
+    }
+
+private:
+    // the hook of item, marked as linked - throws if it already is
+    static ListHook *claim(T &item) {
+        ListHook *hook = &(item.*Hook);
+        if (hook->isLinked()) {
+            throw std::logic_error("Item is already linked into a list.");
+        }
+        // a back pointer instead of the hook's offset in T - no pointer arithmetic over T's layout
+        hook->owner = std::addressof(item);
+        return hook;
+    }
+};
+
+template<class T, ListHook T::*Hook>
+class IntrusiveList<T, Hook>::iterator {
+    friend class IntrusiveList<T, Hook>;
+
+    ListHook *p;
+
+    explicit iterator(ListHook *pt) : p(pt) {}
+
+public:
+    bool operator!=(const iterator &itr) const {
+        return p != itr.p;
+    }
+
+    bool operator==(const iterator &itr) const {
+        return p == itr.p;
+    }
+
+    iterator &operator++() {
+        if (p == nullptr) {
+            throw std::out_of_range("");
+        }
+        p = p->getNext();
+        return *this;
+    }
+
+    T &operator*() const {
+        if (p == nullptr) {
+            throw std::out_of_range("");
+        }
+        return owner(p);
+    }
+
+    T *operator->() const {
+        return &**this;
+    }
+};
+
+#endif //DATA_STRUCTURES_INTRUSIVELIST_H
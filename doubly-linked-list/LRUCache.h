@@ -0,0 +1,91 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_LRUCACHE_H
+#define DATA_STRUCTURES_LRUCACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include "LinkList.h"
+
+/*
+            Least recently used cache
+            the doubly linked list keeps the entries from most to least recently used and the
+            hash index maps a key to its list node, so get/put are O(1) and the back of the
+            list is the entry to evict
+                                                                        */
+
+template<class K, class V, class Hash = std::hash<K>>
+class LRUCache {
+    typedef std::pair<K, V> Entry;
+    typedef typename LinkedList<Entry>::iterator EntryIterator;
+
+    std::size_t capacity;
+    LinkedList<Entry> entries;
+    std::unordered_map<K, EntryIterator, Hash> index;
+
+public:
+
+    explicit LRUCache(std::size_t _capacity) : capacity(_capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("LRUCache capacity must be positive");
+        }
+        index.reserve(capacity);
+    }
+
+    // O(1) - false on a miss, a hit becomes the most recently used entry
+    bool get(const K &key, V &value) {
+        auto found = index.find(key);
+        if (found == index.end()) {
+            return false;
+        }
+        entries.moveToFront(found->second);
+        value = found->second->second;
+        return true;
+    }
+
+    // O(1) - inserts or overwrites, evicting the least recently used entry when full
+    void put(const K &key, const V &value) {
+        auto found = index.find(key);
+        if (found != index.end()) {
+            found->second->second = value;
+            entries.moveToFront(found->second);
+            return;
+        }
+
+        if (index.size() == capacity) {
+            index.erase(entries.back().first);
+            entries.popBack();
+        }
+        index.emplace(key, entries.pushFront(Entry(key, value)));
+    }
+
+    // does not count as a use
+    bool contains(const K &key) const {
+        return index.find(key) != index.end();
+    }
+
+    bool remove(const K &key) {
+        auto found = index.find(key);
+        if (found == index.end()) {
+            return false;
+        }
+        entries.erase(found->second);
+        index.erase(found);
+        return true;
+    }
+
+    std::size_t size() const {
+        return index.size();
+    }
+
+    std::size_t getCapacity() const {
+        return capacity;
+    }
+};
+
+#endif //DATA_STRUCTURES_LRUCACHE_H
@@ -0,0 +1,60 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_LINKCHAIN_H
+#define DATA_STRUCTURES_LINKCHAIN_H
+
+/*
+            Head/tail bookkeeping of a doubly linked chain, shared by LinkedList (./LinkList.h),
+            which links its own nodes, and IntrusiveList (./IntrusiveList.h), which links the
+            hooks inside the user's objects. Link only needs getPrev/setPrev/getNext/setNext
+                                                                        */
+
+template<class Link>
+struct LinkChain {
+    Link *head;
+    Link *tail;
+    int size;
+
+    LinkChain() : head(nullptr), tail(nullptr), size(0) {
+    }
+
+    // O(1) - before == nullptr links at the end
+    void linkBefore(Link *before, Link *link) {
+        Link *after = before ? before->getPrev() : tail;
+        link->setPrev(after);
+        link->setNext(before);
+        if (after) {
+            after->setNext(link);
+        } else {
+            // nothing before it - link is the new first item
+            head = link;
+        }
+        if (before) {
+            before->setPrev(link);
+        } else {
+            tail = link;
+        }
+        ++size;
+    }
+
+    // O(1) - link must be in this chain
+    void unlink(Link *link) {
+        if (link->getPrev()) {
+            link->getPrev()->setNext(link->getNext());
+        } else {
+            head = link->getNext();
+        }
+        if (link->getNext()) {
+            link->getNext()->setPrev(link->getPrev());
+        } else {
+            tail = link->getPrev();
+        }
+        link->setPrev(nullptr);
+        link->setNext(nullptr);
+        --size;
+    }
+};
+
+#endif //DATA_STRUCTURES_LINKCHAIN_H
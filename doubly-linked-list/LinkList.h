@@ -5,50 +5,163 @@
 #ifndef DATA_STRUCTURES_LINKLIST_H
 #define DATA_STRUCTURES_LINKLIST_H
 
-template<class T>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../allocator/SlabArena.h"
+#include "LinkChain.h"
+
+// by default nodes and items come from per-list slab arenas (../allocator/SlabArena.h)
+template<class T, template<class> class Allocator = SlabArena>
 class LinkedList {
+    template<class, template<class> class> friend class LinkedList;
+
     struct Node;
-    Node *head;
-    Node *tail;
+    Allocator<Node> nodes;
+    Allocator<T> payloads;
+    // head, tail and size - the linking itself is shared with IntrusiveList (./LinkChain.h)
+    LinkChain<Node> links;
 public:
 
-    LinkedList() : head(new Node(nullptr)), tail(nullptr) {
+    LinkedList() {
     }
 
     ~LinkedList() {
-        delete head;
-    }
-
-    void insert(const T &data) {
-        T *new_data = new T(data);
-
-        // this is the first item in the linked list
-        if (!tail) {
-            // both of the pointer are pointing to the same node
-            head->data = new_data;
-            tail = head;
-        } else {
-            // inserting the new item to end of the list
-            Node *new_node = new Node(new_data);
-            new_node->setPrev(tail);
-            tail->setNext(new_node);
-            tail = new_node;
+        // an arena frees everything at once, we only walk when someone must see each node
+        if (Allocator<Node>::RELEASES_ALL && Allocator<T>::RELEASES_ALL && std::is_trivially_destructible<T>::value) {
+            return;
+        }
+        while (links.head) {
+            Node *next = links.head->next;
+            freeNode(links.head);
+            links.head = next;
+        }
+    }
+
+    LinkedList(const LinkedList &other) = delete;
+
+    LinkedList &operator=(const LinkedList &other) = delete;
+
+    class iterator;
+
+    iterator begin() const {
+        return iterator(links.head);
+    }
+
+    iterator end() const {
+        return iterator(nullptr);
+    }
+
+    // O(1) - inserting the new item to the end of the list
+    iterator insert(const T &data) {
+        return linkBefore(nullptr, nodes.create(payloads.create(data)));
+    }
+
+    // O(1) - inserting the new item to the beginning of the list
+    iterator pushFront(const T &data) {
+        return linkBefore(links.head, nodes.create(payloads.create(data)));
+    }
+
+    // O(1) - returns the item after the erased one
+    iterator erase(iterator pos) {
+        Node *node = checkNode(pos);
+        Node *next = node->next;
+        unlink(node);
+        freeNode(node);
+        return iterator(next);
+    }
+
+    // O(1) - moves the item at it (in other) right before pos (in this list), returns its new position.
+    // within one list, or between two heap lists, the node is relinked and it stays valid.
+    // otherwise (an arena list on either side) nodes cannot change lists: the item is moved into
+    // a fresh node of this list and the old one is freed - it and any reference to the item are invalidated
+    template<template<class> class OtherAllocator>
+    iterator splice(iterator pos, LinkedList<T, OtherAllocator> &other,
+                    typename LinkedList<T, OtherAllocator>::iterator it) {
+        typename LinkedList<T, OtherAllocator>::Node *node = other.checkNode(it);
+        if constexpr (std::is_same<LinkedList<T, OtherAllocator>, LinkedList<T, Allocator>>::value) {
+            if (&other == this || (!Allocator<Node>::RELEASES_ALL && !Allocator<T>::RELEASES_ALL)) {
+                if (node == pos.p) {
+                    return it;
+                }
+                other.unlink(node);
+                return linkBefore(pos.p, node);
+            }
+        }
+        iterator moved = linkBefore(pos.p, nodes.create(payloads.create(std::move(*node->data))));
+        other.erase(it);
+        return moved;
+    }
+
+    // O(1) - relinks the item at it as the first item
+    void moveToFront(iterator it) {
+        splice(begin(), *this, it);
+    }
+
+    T &front() const {
+        if (!links.head) {
+            throw std::out_of_range("List is empty.");
         }
+        return *links.head->data;
+    }
+
+    T &back() const {
+        if (!links.tail) {
+            throw std::out_of_range("List is empty.");
+        }
+        return *links.tail->data;
+    }
+
+    void popBack() {
+        if (!links.tail) {
+            throw std::out_of_range("List is empty.");
+        }
+        erase(iterator(links.tail));
+    }
+
+    bool isEmpty() const {
+        return links.size == 0;
+    }
+
+    int getSize() const {
+        return links.size;
     }
 
     void traverse() {
-        Node *it = head;
+        Node *it = links.head;
         while (it) {
             std::cout << *it << std::endl;
             it = it->next;
         }
     }
 
+private:
+    // before == nullptr links at the end
+    iterator linkBefore(Node *before, Node *node) {
+        links.linkBefore(before, node);
+        return iterator(node);
+    }
+
+    void unlink(Node *node) {
+        links.unlink(node);
+    }
+
+    void freeNode(Node *node) {
+        payloads.destroy(node->data);
+        nodes.destroy(node);
+    }
 
+    static Node *checkNode(iterator it) {
+        if (it.p == nullptr) {
+            throw std::out_of_range("");
+        }
+        return it.p;
+    }
 };
 
-template<class T>
-struct LinkedList<T>::Node {
+template<class T, template<class> class Allocator>
+struct LinkedList<T, Allocator>::Node {
+    // the list owns data and frees it through its allocator
     T *data;
     Node *prev;
     Node *next;
@@ -57,11 +170,6 @@ struct LinkedList<T>::Node {
 
     }
 
-    ~Node() {
-        delete data;
-        delete next;
-    }
-
     T *getData() const {
         return data;
     }
@@ -92,4 +200,43 @@ struct LinkedList<T>::Node {
     }
 };
 
+template<class T, template<class> class Allocator>
+class LinkedList<T, Allocator>::iterator {
+    friend class LinkedList<T, Allocator>;
+
+    Node *p;
+
+    explicit iterator(Node *pt) : p(pt) {}
+
+public:
+    iterator() : p(nullptr) {}
+
+    bool operator!=(const iterator &itr) const {
+        return p != itr.p;
+    }
+
+    bool operator==(const iterator &itr) const {
+        return p == itr.p;
+    }
+
+    iterator &operator++() {
+        if (p == nullptr) {
+            throw std::out_of_range("");
+        }
+        p = p->next;
+        return *this;
+    }
+
+    T &operator*() const {
+        if (p == nullptr) {
+            throw std::out_of_range("");
+        }
+        return *p->data;
+    }
+
+    T *operator->() const {
+        return &**this;
+    }
+};
+
 #endif //DATA_STRUCTURES_LINKLIST_H
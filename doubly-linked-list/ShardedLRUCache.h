@@ -0,0 +1,244 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_SHARDEDLRUCACHE_H
+#define DATA_STRUCTURES_SHARDEDLRUCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include "LinkList.h"
+
+/*
+            Concurrent LRU cache split into independently locked shards
+            each shard keeps its entries the way LRUCache (./LRUCache.h) does - a list from most to
+            least recently used plus a hash index - behind a reader/writer lock. a hit only takes
+            the shared lock and records itself in a lossy ring buffer, the recorded hits are
+            replayed onto the list in one batch whenever a writer holds the shard exclusively
+            (or the buffer fills up) - so get almost never contends on the list
+                                                                        */
+
+template<class K, class V, class Hash = std::hash<K>>
+class ShardedLRUCache {
+public:
+    // called with the evicted entry while its shard is locked - must not call back into the cache
+    typedef std::function<void(const K &, const V &)> EvictionCallback;
+
+    struct Stats {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+    };
+
+private:
+    typedef std::pair<K, V> Entry;
+    typedef typename LinkedList<Entry>::iterator EntryIterator;
+    typedef std::unordered_map<K, EntryIterator, Hash> Index;
+    typedef typename Index::value_type IndexEntry;
+
+    // hits buffered per shard before a reader tries to replay them itself
+    static constexpr std::size_t READ_BUFFER_SIZE = 128;
+    static constexpr std::size_t DRAIN_THRESHOLD = READ_BUFFER_SIZE / 2;
+
+    struct alignas(64) Shard {
+        std::shared_mutex lock;
+        LinkedList<Entry> entries;
+        Index index;
+        std::size_t capacity;
+
+        // ring of index entries that were hit, claimed by CAS, read only under the exclusive lock
+        std::atomic<IndexEntry *> read_buffer[READ_BUFFER_SIZE];
+        std::atomic<std::size_t> write_pos;
+        std::atomic<std::size_t> read_pos;
+
+        std::atomic<std::uint64_t> hits;
+        std::atomic<std::uint64_t> misses;
+        std::atomic<std::uint64_t> evictions;
+
+        Shard() : capacity(0), write_pos(0), read_pos(0), hits(0), misses(0), evictions(0) {
+            for (std::atomic<IndexEntry *> &slot : read_buffer) {
+                slot.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::size_t shard_count;
+    std::unique_ptr<Shard[]> shards;
+    Hash hash;
+    EvictionCallback on_evict;
+
+public:
+
+    // the shard count is rounded up to a power of two, then halved while it exceeds capacity.
+    // capacity is split between the shards so that their capacities add up to exactly capacity
+    explicit ShardedLRUCache(std::size_t capacity, std::size_t _shard_count = 16,
+                             EvictionCallback _on_evict = EvictionCallback()) :
+            shard_count(shardCount(_shard_count, capacity)), shards(new Shard[shard_count]),
+            on_evict(std::move(_on_evict)) {
+        if (capacity == 0) {
+            throw std::invalid_argument("ShardedLRUCache capacity must be positive");
+        }
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            // the first capacity % shard_count shards take one entry of the remainder each
+            shards[i].capacity = capacity / shard_count + (i < capacity % shard_count);
+            shards[i].index.reserve(shards[i].capacity);
+        }
+    }
+
+    ShardedLRUCache(const ShardedLRUCache &other) = delete;
+
+    ShardedLRUCache &operator=(const ShardedLRUCache &other) = delete;
+
+    // false on a miss - a hit takes only the shard's shared lock
+    bool get(const K &key, V &value) {
+        Shard &shard = shardFor(key);
+        bool replay = false;
+        {
+            std::shared_lock<std::shared_mutex> guard(shard.lock);
+            auto found = shard.index.find(key);
+            if (found == shard.index.end()) {
+                shard.misses.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            value = found->second->second;
+            replay = recordHit(shard, &*found);
+        }
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+
+        // the buffer is filling up - replay it if nobody else holds the shard
+        if (replay) {
+            std::unique_lock<std::shared_mutex> guard(shard.lock, std::try_to_lock);
+            if (guard) {
+                drain(shard);
+            }
+        }
+        return true;
+    }
+
+    // inserts or overwrites, evicting the shard's least recently used entry when it is full
+    void put(const K &key, const V &value) {
+        Shard &shard = shardFor(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        drain(shard);
+
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            found->second->second = value;
+            shard.entries.moveToFront(found->second);
+            return;
+        }
+
+        if (shard.index.size() == shard.capacity) {
+            Entry &victim = shard.entries.back();
+            if (on_evict) {
+                on_evict(victim.first, victim.second);
+            }
+            shard.index.erase(victim.first);
+            shard.entries.popBack();
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        shard.index.emplace(key, shard.entries.pushFront(Entry(key, value)));
+    }
+
+    bool remove(const K &key) {
+        Shard &shard = shardFor(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        drain(shard);
+
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) {
+            return false;
+        }
+        shard.entries.erase(found->second);
+        shard.index.erase(found);
+        return true;
+    }
+
+    // does not count as a use
+    bool contains(const K &key) {
+        Shard &shard = shardFor(key);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        return shard.index.find(key) != shard.index.end();
+    }
+
+    // a sum over the shards - other threads may change it right away
+    std::size_t size() {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            total += shards[i].index.size();
+        }
+        return total;
+    }
+
+    Stats getStats() const {
+        Stats stats{0, 0, 0};
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            stats.hits += shards[i].hits.load(std::memory_order_relaxed);
+            stats.misses += shards[i].misses.load(std::memory_order_relaxed);
+            stats.evictions += shards[i].evictions.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+private:
+    // a power of two, at most capacity (but at least one) - an empty shard could never hold anything
+    static std::size_t shardCount(std::size_t requested, std::size_t capacity) {
+        std::size_t power = 1;
+        while (power < requested) {
+            power <<= 1;
+        }
+        while (power > 1 && power > capacity) {
+            power >>= 1;
+        }
+        return power;
+    }
+
+    Shard &shardFor(const K &key) {
+        std::size_t h = hash(key);
+        // spread weak hashes (identity hash of integers) over the shards
+        h ^= h >> 16;
+        h *= 0x45d9f3b;
+        h ^= h >> 16;
+        return shards[h & (shard_count - 1)];
+    }
+
+    // called under the shared lock - a full buffer simply drops the hit
+    // returns true when the buffer is full enough to be worth replaying
+    static bool recordHit(Shard &shard, IndexEntry *entry) {
+        std::size_t pos = shard.write_pos.load(std::memory_order_relaxed);
+        while (true) {
+            std::size_t pending = pos - shard.read_pos.load(std::memory_order_acquire);
+            if (pending >= READ_BUFFER_SIZE) {
+                return true;
+            }
+            if (shard.write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                shard.read_buffer[pos % READ_BUFFER_SIZE].store(entry, std::memory_order_release);
+                return pending + 1 >= DRAIN_THRESHOLD;
+            }
+        }
+    }
+
+    // called under the exclusive lock - every reader that claimed a slot has already stored it,
+    // and nothing was erased since it was recorded because erasing also drains first
+    static void drain(Shard &shard) {
+        std::size_t end = shard.write_pos.load(std::memory_order_acquire);
+        for (std::size_t pos = shard.read_pos.load(std::memory_order_relaxed); pos != end; ++pos) {
+            IndexEntry *entry = shard.read_buffer[pos % READ_BUFFER_SIZE].exchange(nullptr, std::memory_order_acquire);
+            if (entry) {
+                shard.entries.moveToFront(entry->second);
+            }
+        }
+        shard.read_pos.store(end, std::memory_order_release);
+    }
+};
+
+#endif //DATA_STRUCTURES_SHARDEDLRUCACHE_H
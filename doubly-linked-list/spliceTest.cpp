@@ -0,0 +1,64 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+// splice between lists of the same and of different allocators - build and run on its own:
+//     g++ -std=c++17 spliceTest.cpp -o spliceTest && ./spliceTest
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "LinkList.h"
+
+template<class List>
+static std::vector<std::string> items(const List &list) {
+    std::vector<std::string> out;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        out.push_back(*it);
+    }
+    return out;
+}
+
+int main() {
+    typedef std::vector<std::string> Items;
+
+    // arena list -> heap list: the item is moved into a node of the heap list
+    LinkedList<std::string> arena;
+    arena.insert("a");
+    arena.insert("b");
+    LinkedList<std::string, HeapAllocator> heap;
+    heap.insert("x");
+    auto moved = heap.splice(heap.begin(), arena, arena.begin());
+    assert(*moved == "a");
+    assert(items(heap) == Items({"a", "x"}));
+    assert(items(arena) == Items({"b"}));
+
+    // heap list -> arena list
+    arena.splice(arena.end(), heap, heap.begin());
+    assert(items(arena) == Items({"b", "a"}));
+    assert(items(heap) == Items({"x"}));
+
+    // heap list -> heap list: the node itself is relinked, the iterator stays valid
+    LinkedList<std::string, HeapAllocator> other_heap;
+    other_heap.insert("y");
+    auto it = heap.begin();
+    auto relinked = other_heap.splice(other_heap.end(), heap, it);
+    assert(relinked == it && *it == "x");
+    assert(items(other_heap) == Items({"y", "x"}));
+    assert(heap.isEmpty());
+
+    // arena list -> arena list
+    LinkedList<std::string> other_arena;
+    other_arena.splice(other_arena.begin(), arena, arena.begin());
+    assert(items(other_arena) == Items({"b"}));
+    assert(items(arena) == Items({"a"}));
+
+    // within one list
+    other_arena.insert("c");
+    other_arena.moveToFront(++other_arena.begin());
+    assert(items(other_arena) == Items({"c", "b"}));
+
+    std::cout << "splice ok" << std::endl;
+    return 0;
+}
@@ -0,0 +1,189 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_EPOCHRECLAMATION_H
+#define DATA_STRUCTURES_EPOCHRECLAMATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/*
+            Process wide epoch based reclamation
+            threads announce the global epoch while they are inside an operation (Guard), the
+            epoch only moves on once every active thread has seen it - so a node retired two
+            epochs ago cannot be referenced by anyone anymore
+                                                                        */
+
+class EpochReclamation {
+public:
+    // retired nodes a thread collects before it tries to advance the epoch
+    static constexpr std::size_t RECLAIM_THRESHOLD = 64;
+
+    // every access to shared nodes must happen while a Guard is alive - guards may nest
+    class Guard {
+    public:
+        Guard() {
+            enter();
+        }
+
+        ~Guard() {
+            exit();
+        }
+
+        Guard(const Guard &other) = delete;
+
+        Guard &operator=(const Guard &other) = delete;
+    };
+
+    // p is already unlinked - reclaim(p) is called once no guard can still see it
+    static void retire(void *p, void (*reclaim)(void *)) {
+        ThreadState &s = state();
+        s.limbo.push_back(Retired{p, reclaim, global_epoch.load()});
+        if (s.limbo.size() >= RECLAIM_THRESHOLD) {
+            tryAdvance();
+            collect(s);
+        }
+    }
+
+private:
+    struct Record {
+        std::atomic<bool> in_use;
+        std::atomic<bool> active;
+        std::atomic<std::uint64_t> epoch;
+        Record *next;
+
+        Record() : in_use(false), active(false), epoch(0), next(nullptr) {}
+    };
+
+    struct Retired {
+        void *p;
+        void (*reclaim)(void *);
+        std::uint64_t epoch;
+    };
+
+    struct ThreadState {
+        Record *record;
+        std::vector<Retired> limbo;
+        int nesting;
+
+        ThreadState() : record(acquireRecord()), nesting(0) {}
+
+        // whatever cannot be reclaimed yet is left for the other threads
+        ~ThreadState() {
+            record->active.store(false);
+            tryAdvance();
+            collect(*this);
+            if (!limbo.empty()) {
+                std::lock_guard<std::mutex> guard(orphans.lock);
+                orphans.limbo.insert(orphans.limbo.end(), limbo.begin(), limbo.end());
+            }
+            record->in_use.store(false);
+        }
+    };
+
+    // retired nodes left behind by exited threads
+    struct Orphans {
+        std::mutex lock;
+        std::vector<Retired> limbo;
+
+        // no thread is running by now, nothing can be referenced
+        ~Orphans() {
+            for (Retired &r : limbo) {
+                r.reclaim(r.p);
+            }
+        }
+    };
+
+    // starts at 2 so "epoch - 2" never wraps
+    static inline std::atomic<std::uint64_t> global_epoch{2};
+
+    // records are never freed, threads reuse the released ones
+    static inline std::atomic<Record *> records{nullptr};
+
+    static inline Orphans orphans;
+
+    static ThreadState &state() {
+        thread_local ThreadState s;
+        return s;
+    }
+
+    static void enter() {
+        ThreadState &s = state();
+        if (s.nesting++ > 0) {
+            return;
+        }
+        s.record->active.store(true);
+        // publish an epoch that is still current after we became visible as active
+        while (true) {
+            std::uint64_t e = global_epoch.load();
+            s.record->epoch.store(e);
+            if (global_epoch.load() == e) {
+                return;
+            }
+        }
+    }
+
+    static void exit() {
+        ThreadState &s = state();
+        if (--s.nesting == 0) {
+            s.record->active.store(false);
+        }
+    }
+
+    // moves the epoch on if every active thread has already seen the current one
+    static void tryAdvance() {
+        std::uint64_t e = global_epoch.load();
+        for (Record *r = records.load(); r; r = r->next) {
+            if (r->active.load() && r->epoch.load() != e) {
+                return;
+            }
+        }
+        global_epoch.compare_exchange_strong(e, e + 1);
+    }
+
+    static void collect(ThreadState &s) {
+        // adopt nodes left behind by exited threads, but never wait for it
+        std::unique_lock<std::mutex> guard(orphans.lock, std::try_to_lock);
+        if (guard && !orphans.limbo.empty()) {
+            s.limbo.insert(s.limbo.end(), orphans.limbo.begin(), orphans.limbo.end());
+            orphans.limbo.clear();
+        }
+        if (guard) {
+            guard.unlock();
+        }
+
+        std::uint64_t safe = global_epoch.load() - 2;
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < s.limbo.size(); ++i) {
+            if (s.limbo[i].epoch <= safe) {
+                s.limbo[i].reclaim(s.limbo[i].p);
+            } else {
+                s.limbo[kept++] = s.limbo[i];
+            }
+        }
+        s.limbo.resize(kept);
+    }
+
+    static Record *acquireRecord() {
+        for (Record *r = records.load(); r; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load() && r->in_use.compare_exchange_strong(expected, true)) {
+                return r;
+            }
+        }
+
+        Record *r = new Record();
+        r->in_use.store(true);
+        Record *old = records.load();
+        do {
+            r->next = old;
+        } while (!records.compare_exchange_weak(old, r));
+        return r;
+    }
+};
+
+#endif //DATA_STRUCTURES_EPOCHRECLAMATION_H
@@ -5,36 +5,60 @@
 #ifndef DATA_STRUCTURES_LINKLIST_H
 #define DATA_STRUCTURES_LINKLIST_H
 
-template<class T>
+#include <type_traits>
+#include "../allocator/SlabArena.h"
+
+// by default nodes and items come from per-list slab arenas (../allocator/SlabArena.h)
+template<class T, template<class> class Allocator = SlabArena>
 class LinkedList {
     struct Node;
+    // declared first - head is allocated from them
+    Allocator<Node> nodes;
+    Allocator<T> payloads;
     Node *head;
+    Node *tail;
     int size;
 public:
 
-    LinkedList() : head(new Node(nullptr)), size(0) {
+    LinkedList() : head(nodes.create(nullptr)), tail(head), size(0) {
     }
 
     ~LinkedList() {
-        delete head;
+        // an arena frees everything at once, we only walk when someone must see each node
+        if (Allocator<Node>::RELEASES_ALL && Allocator<T>::RELEASES_ALL && std::is_trivially_destructible<T>::value) {
+            return;
+        }
+        // iteratively - a recursive ~Node overflows the stack on long lists
+        while (head) {
+            Node *next = head->next;
+            freeNode(head);
+            head = next;
+        }
     }
 
+    LinkedList(const LinkedList &other) = delete;
+
+    LinkedList &operator=(const LinkedList &other) = delete;
+
     void insertBeginning(const T &data) {
         ++size;
-        T *new_data = new T(data);
+        T *new_data = payloads.create(data);
 
         // this is the first item in the linked list
         if (!head->data) {
             head->data = new_data;
         } else {
-            // inserting the new item to end of the list
-            Node *new_node = new Node(new_data);
+            // inserting the new item to the beginning of the list
+            Node *new_node = nodes.create(new_data);
             new_node->next = head;
             head = new_node;
         }
     }
 
     void traverse() {
+        if (!head->data) {
+            return;
+        }
         Node *it = head;
         while (it) {
             std::cout << *it << std::endl;
@@ -49,7 +73,15 @@ public:
 
         if (*head->data == data) {
             --size;
-            delete head->data;
+            if (head->next) {
+                Node *to_remove = head;
+                head = head->next;
+                freeNode(to_remove);
+            } else {
+                // keep the (now empty) head node around like a fresh list does
+                payloads.destroy(head->data);
+                head->data = nullptr;
+            }
         } else {
             remove(data, head, head->next);
         }
@@ -59,44 +91,73 @@ public:
         return size;
     }
 
+    // O(1) thanks to the tail pointer
     void insertEnd(const T &data) {
+        ++size;
         if (head->data == nullptr) {
-            head->data = new T(data);
+            head->data = payloads.create(data);
         } else {
-            insertEnd(data, head);
+            tail->next = nodes.create(payloads.create(data));
+            tail = tail->next;
         }
     }
 
+    // builds the whole chain first and then links it after the tail in one step
+    template<class Iterator>
+    void appendRange(Iterator first, Iterator last) {
+        if (first == last) {
+            return;
+        }
+        Node *chain_head = nodes.create(payloads.create(*first));
+        Node *chain_tail = chain_head;
+        int added = 1;
+        for (++first; first != last; ++first, ++added) {
+            chain_tail->next = nodes.create(payloads.create(*first));
+            chain_tail = chain_tail->next;
+        }
+
+        if (head->data == nullptr) {
+            // the empty head node is replaced by the chain
+            freeNode(head);
+            head = chain_head;
+        } else {
+            tail->next = chain_head;
+        }
+        tail = chain_tail;
+        size += added;
+    }
+
 private:
+    void freeNode(Node *node) {
+        if (node->data) {
+            payloads.destroy(node->data);
+        }
+        nodes.destroy(node);
+    }
+
+    // removes every node from actual on (prev is the node before it) that holds data
     void remove(const T &data, Node *prev, Node *actual) {
         while (actual != nullptr) {
             if (*actual->data == data) {
                 --size;
                 prev->next = actual->next;
-                actual->next = nullptr;
-                delete actual;
-                actual = nullptr;
+                if (tail == actual) {
+                    tail = prev;
+                }
+                freeNode(actual);
+                // prev stays, its new next is checked next
+                actual = prev->next;
             } else {
                 prev = actual;
                 actual = actual->next;
             }
         }
     }
-
-    void insertEnd(const T &data, Node *node) {
-        // in order to it in O(1) running time complexity check out - ../doubly-linked-list
-        if (node->next != nullptr) {
-            insertEnd(data, node->next);
-        } else {
-            node->next = new Node(new T(data));
-            ++size;
-        }
-
-    }
 };
 
-template<class T>
-struct LinkedList<T>::Node {
+template<class T, template<class> class Allocator>
+struct LinkedList<T, Allocator>::Node {
+    // the list owns data and frees it through its allocator
     T *data;
     Node *next;
 
@@ -104,11 +165,6 @@ struct LinkedList<T>::Node {
 
     }
 
-    ~Node() {
-        delete data;
-        delete next;
-    }
-
     T *getData() const {
         return data;
     }
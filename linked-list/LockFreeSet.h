@@ -0,0 +1,189 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_LOCKFREESET_H
+#define DATA_STRUCTURES_LOCKFREESET_H
+
+#include <atomic>
+#include <cstdint>
+#include "EpochReclamation.h"
+
+/*
+            Lock free sorted set (Harris linked list)
+            remove first marks the low bit of the victim's next pointer (logical delete) and
+            then unlinks it, searches unlink every marked node they pass.
+            unlinked nodes are freed through epoch based reclamation
+                                                                        */
+
+template<class T>
+class LockFreeSet {
+    struct Node;
+    // sentinel - its data is never read
+    Node *head;
+
+public:
+
+    LockFreeSet() : head(new Node()) {
+    }
+
+    // no other thread may use the set while it is destroyed
+    ~LockFreeSet() {
+        Node *it = head;
+        while (it) {
+            Node *next = unmark(it->next.load());
+            delete it;
+            it = next;
+        }
+    }
+
+    LockFreeSet(const LockFreeSet &other) = delete;
+
+    LockFreeSet &operator=(const LockFreeSet &other) = delete;
+
+    // false if data is already in the set
+    bool insert(const T &data) {
+        EpochReclamation::Guard guard;
+        Node *new_node = new Node(data);
+        while (true) {
+            Node *left;
+            Node *right = search(data, left);
+            if (right && !(data < right->data)) {
+                delete new_node;
+                return false;
+            }
+            new_node->next.store(right);
+            if (left->next.compare_exchange_strong(right, new_node)) {
+                return true;
+            }
+        }
+    }
+
+    // false if data is not in the set
+    bool remove(const T &data) {
+        EpochReclamation::Guard guard;
+        Node *left;
+        Node *right;
+        Node *right_next;
+        while (true) {
+            right = search(data, left);
+            if (!right || data < right->data) {
+                return false;
+            }
+            right_next = right->next.load();
+            // logical delete - whoever marks the node owns the removal
+            if (!isMarked(right_next) && right->next.compare_exchange_strong(right_next, mark(right_next))) {
+                break;
+            }
+        }
+
+        // physical delete, if it fails the next search cleans up after us
+        Node *expected = right;
+        if (left->next.compare_exchange_strong(expected, right_next)) {
+            EpochReclamation::retire(right, &reclaim);
+        } else {
+            search(data, left);
+        }
+        return true;
+    }
+
+    // never writes - marked nodes are skipped, not unlinked
+    bool contains(const T &data) const {
+        EpochReclamation::Guard guard;
+        Node *it = unmark(head->next.load());
+        while (it && it->data < data) {
+            it = unmark(it->next.load());
+        }
+        return it && !(data < it->data) && !isMarked(it->next.load());
+    }
+
+    // a snapshot only - other threads may change it right away
+    bool isEmpty() const {
+        EpochReclamation::Guard guard;
+        for (Node *it = unmark(head->next.load()); it; it = unmark(it->next.load())) {
+            if (!isMarked(it->next.load())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static bool isMarked(Node *p) {
+        return reinterpret_cast<std::uintptr_t>(p) & 1;
+    }
+
+    static Node *mark(Node *p) {
+        return reinterpret_cast<Node *>(reinterpret_cast<std::uintptr_t>(p) | 1);
+    }
+
+    static Node *unmark(Node *p) {
+        return reinterpret_cast<Node *>(reinterpret_cast<std::uintptr_t>(p) & ~std::uintptr_t(1));
+    }
+
+    static void reclaim(void *p) {
+        delete static_cast<Node *>(p);
+    }
+
+    // returns the first unmarked node with data >= key (nullptr at the end) and sets left to
+    // its unmarked predecessor, unlinking any marked nodes found between them
+    // must be called under an EpochReclamation::Guard
+    Node *search(const T &key, Node *&left) {
+        while (true) {
+            Node *left_next = nullptr;
+            Node *it = head;
+            Node *it_next = head->next.load();
+
+            // find left and right - right is the first unmarked node not smaller than key
+            do {
+                if (!isMarked(it_next)) {
+                    left = it;
+                    left_next = it_next;
+                }
+                it = unmark(it_next);
+                if (!it) {
+                    break;
+                }
+                it_next = it->next.load();
+            } while (isMarked(it_next) || it->data < key);
+            Node *right = it;
+
+            // nothing marked in between
+            if (left_next == right) {
+                if (right && isMarked(right->next.load())) {
+                    continue;
+                }
+                return right;
+            }
+
+            // unlink the marked run left_next ... right in one step
+            Node *expected = left_next;
+            if (left->next.compare_exchange_strong(expected, right)) {
+                // marked nodes never change their next, so the run is ours to retire
+                for (Node *victim = left_next; victim != right;) {
+                    Node *next = unmark(victim->next.load());
+                    EpochReclamation::retire(victim, &reclaim);
+                    victim = next;
+                }
+                if (right && isMarked(right->next.load())) {
+                    continue;
+                }
+                return right;
+            }
+        }
+    }
+};
+
+template<class T>
+struct LockFreeSet<T>::Node {
+    // stored inline - a concurrent reader must not chase a second pointer that may be freed
+    T data;
+    // the low bit marks this node as logically deleted
+    std::atomic<Node *> next;
+
+    Node() : data(), next(nullptr) {}
+
+    explicit Node(const T &_data) : data(_data), next(nullptr) {}
+};
+
+#endif //DATA_STRUCTURES_LOCKFREESET_H
@@ -0,0 +1,302 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_SKIPLIST_H
+#define DATA_STRUCTURES_SKIPLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+/*
+            Skip list - the singly linked list (./LinkList.h) where every node carries a tower
+            of next pointers. level 0 is the plain sorted list, each level above skips about
+            3 of every 4 nodes below it, so find/insert/erase are O(log n) expected.
+            a node and its tower are one allocation carved from the list's own arena
+                                                                        */
+
+template<class T, class Cmp = std::less<T>>
+class SkipList {
+    struct Node;
+
+    static constexpr int MAX_LEVEL = 32;
+
+    // towers are carved out of blocks of this size, freed towers are kept per height
+    static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+    struct Block {
+        Block *next;
+    };
+
+    // head[level] is the first node of that level
+    Node *head[MAX_LEVEL];
+    int level;
+    int size;
+    Cmp cmp;
+    std::uint64_t seed;
+
+    Block *blocks;
+    char *bump;
+    char *bump_end;
+    Node *free_towers[MAX_LEVEL + 1];
+
+public:
+
+    explicit SkipList(const Cmp &_cmp = Cmp()) : level(1), size(0), cmp(_cmp), seed(0x9E3779B97F4A7C15ULL),
+                                                 blocks(nullptr), bump(nullptr), bump_end(nullptr) {
+        for (Node *&h : head) {
+            h = nullptr;
+        }
+        for (Node *&f : free_towers) {
+            f = nullptr;
+        }
+    }
+
+    ~SkipList() {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (Node *it = head[0]; it; it = it->tower()[0]) {
+                it->data.~T();
+            }
+        }
+        // the towers live inside the blocks - no per node delete
+        while (blocks) {
+            Block *next = blocks->next;
+            ::operator delete(blocks, std::align_val_t(BLOCK_ALIGN));
+            blocks = next;
+        }
+    }
+
+    SkipList(const SkipList &other) = delete;
+
+    SkipList &operator=(const SkipList &other) = delete;
+
+    class const_iterator;
+
+    const_iterator begin() const {
+        return const_iterator(head[0]);
+    }
+
+    const_iterator end() const {
+        return const_iterator(nullptr);
+    }
+
+    // first item not less than data - O(log n) expected
+    const_iterator lowerBound(const T &data) const {
+        Node *const *x = head;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x[i] && cmp(x[i]->data, data)) {
+                x = x[i]->tower();
+            }
+        }
+        return const_iterator(x[0]);
+    }
+
+    // end() if data is not in the list
+    const_iterator find(const T &data) const {
+        const_iterator it = lowerBound(data);
+        if (it.p && !cmp(data, it.p->data)) {
+            return it;
+        }
+        return end();
+    }
+
+    bool contains(const T &data) const {
+        return find(data) != end();
+    }
+
+    // false if an equal item is already in the list
+    bool insert(const T &data) {
+        Node **update[MAX_LEVEL];
+        Node **x = head;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x[i] && cmp(x[i]->data, data)) {
+                x = x[i]->tower();
+            }
+            update[i] = x;
+        }
+        if (x[0] && !cmp(data, x[0]->data)) {
+            return false;
+        }
+
+        int height = randomLevel();
+        if (height > level) {
+            for (int i = level; i < height; ++i) {
+                update[i] = head;
+            }
+            level = height;
+        }
+
+        Node *new_node = createNode(data, height);
+        for (int i = 0; i < height; ++i) {
+            new_node->tower()[i] = update[i][i];
+            update[i][i] = new_node;
+        }
+        ++size;
+        return true;
+    }
+
+    // false if data is not in the list
+    bool erase(const T &data) {
+        Node **update[MAX_LEVEL];
+        Node **x = head;
+        for (int i = level - 1; i >= 0; --i) {
+            while (x[i] && cmp(x[i]->data, data)) {
+                x = x[i]->tower();
+            }
+            update[i] = x;
+        }
+        Node *target = x[0];
+        if (!target || cmp(data, target->data)) {
+            return false;
+        }
+
+        for (int i = 0; i < target->height; ++i) {
+            update[i][i] = target->tower()[i];
+        }
+        while (level > 1 && !head[level - 1]) {
+            --level;
+        }
+        destroyNode(target);
+        --size;
+        return true;
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    void traverse() const {
+        for (Node *it = head[0]; it; it = it->tower()[0]) {
+            std::cout << "data: " << it->data << std::endl;
+        }
+    }
+
+private:
+    static constexpr std::size_t BLOCK_ALIGN = alignof(Node) > alignof(Block) ? alignof(Node) : alignof(Block);
+
+    // 1 with probability 3/4, 2 with 3/16 ... (p = 1/4)
+    int randomLevel() {
+        // xorshift64*
+        seed ^= seed >> 12;
+        seed ^= seed << 25;
+        seed ^= seed >> 27;
+        std::uint64_t bits = seed * 0x2545F4914F6CDD1DULL;
+        int height = 1;
+        while (height < MAX_LEVEL && (bits & 3) == 0) {
+            ++height;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    static std::size_t towerBytes(int height) {
+        std::size_t bytes = sizeof(Node) + height * sizeof(Node *);
+        // keep the next tower in the block aligned
+        return (bytes + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+    }
+
+    Node *createNode(const T &data, int height) {
+        void *p;
+        if (free_towers[height]) {
+            // a freed tower of the same height keeps its next free tower in tower()[0]
+            Node *reuse = free_towers[height];
+            free_towers[height] = reuse->tower()[0];
+            p = reuse;
+        } else {
+            p = carve(towerBytes(height));
+        }
+        Node *node = new(p) Node(data, height);
+        for (int i = 0; i < height; ++i) {
+            node->tower()[i] = nullptr;
+        }
+        return node;
+    }
+
+    void destroyNode(Node *node) {
+        int height = node->height;
+        node->data.~T();
+        node->tower()[0] = free_towers[height];
+        free_towers[height] = node;
+    }
+
+    void *carve(std::size_t bytes) {
+        if (bump == nullptr || (std::size_t) (bump_end - bump) < bytes) {
+            std::size_t header = (sizeof(Block) + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+            std::size_t block_bytes = header + bytes > BLOCK_SIZE ? header + bytes : BLOCK_SIZE;
+            Block *block = static_cast<Block *>(::operator new(block_bytes, std::align_val_t(BLOCK_ALIGN)));
+            block->next = blocks;
+            blocks = block;
+            bump = reinterpret_cast<char *>(block) + header;
+            bump_end = reinterpret_cast<char *>(block) + block_bytes;
+        }
+        void *p = bump;
+        bump += bytes;
+        return p;
+    }
+};
+
+// the tower of next pointers follows the node in the same allocation
+template<class T, class Cmp>
+struct alignas(T) alignas(void *) SkipList<T, Cmp>::Node {
+    // tower()[0] is the plain linked list next
+    T data;
+    int height;
+
+    Node(const T &_data, int _height) : data(_data), height(_height) {}
+
+    Node **tower() {
+        return reinterpret_cast<Node **>(this + 1);
+    }
+
+    Node *const *tower() const {
+        return reinterpret_cast<Node *const *>(this + 1);
+    }
+};
+
+template<class T, class Cmp>
+class SkipList<T, Cmp>::const_iterator {
+    friend class SkipList<T, Cmp>;
+
+    Node *p;
+
+    explicit const_iterator(Node *pt) : p(pt) {}
+
+public:
+    bool operator!=(const const_iterator &itr) const {
+        return p != itr.p;
+    }
+
+    bool operator==(const const_iterator &itr) const {
+        return p == itr.p;
+    }
+
+    const_iterator &operator++() {
+        if (p == nullptr) {
+            throw std::out_of_range("");
+        }
+        p = p->tower()[0];
+        return *this;
+    }
+
+    const T &operator*() const {
+        if (p == nullptr) {
+            throw std::out_of_range("");
+        }
+        return p->data;
+    }
+
+    const T *operator->() const {
+        return &**this;
+    }
+};
+
+#endif //DATA_STRUCTURES_SKIPLIST_H
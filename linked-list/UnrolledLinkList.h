@@ -0,0 +1,197 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_UNROLLEDLINKLIST_H
+#define DATA_STRUCTURES_UNROLLEDLINKLIST_H
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <utility>
+
+/*
+            Unrolled singly linked list - same API as LinkedList (./LinkList.h)
+            every node keeps up to CAPACITY items inline (about 64 bytes of T), so a scan
+            touches one node per CAPACITY items instead of two pointers per item
+                                                                        */
+
+template<class T, int CAPACITY = (64 / sizeof(T) > 2 ? 64 / sizeof(T) : 2)>
+class UnrolledLinkedList {
+    static_assert(CAPACITY >= 2, "a node must hold at least two items");
+
+    struct Node;
+    Node *head;
+    Node *tail;
+    int size;
+
+public:
+
+    UnrolledLinkedList() : head(nullptr), tail(nullptr), size(0) {
+    }
+
+    ~UnrolledLinkedList() {
+        // iteratively - a long list must not recurse once per node
+        while (head) {
+            Node *next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+
+    UnrolledLinkedList(const UnrolledLinkedList &other) = delete;
+
+    UnrolledLinkedList &operator=(const UnrolledLinkedList &other) = delete;
+
+    // O(CAPACITY) - shifts the first node, opens a new one when it is full
+    void insertBeginning(const T &data) {
+        if (!head || head->count == CAPACITY) {
+            Node *new_node = new Node();
+            new_node->next = head;
+            head = new_node;
+            if (!tail) {
+                tail = head;
+            }
+        }
+        head->insertAt(0, data);
+        ++size;
+    }
+
+    // O(1) - appends to the last node, opens a new one when it is full
+    void insertEnd(const T &data) {
+        if (!tail || tail->count == CAPACITY) {
+            Node *new_node = new Node();
+            if (tail) {
+                tail->next = new_node;
+            } else {
+                head = new_node;
+            }
+            tail = new_node;
+        }
+        tail->insertAt(tail->count, data);
+        ++size;
+    }
+
+    // removes the first item equal to data
+    // a node left less than half full borrows from / merges with its successor
+    void remove(const T &data) {
+        Node *prev = nullptr;
+        for (Node *node = head; node; prev = node, node = node->next) {
+            for (int i = 0; i < node->count; ++i) {
+                if (node->at(i) == data) {
+                    node->removeAt(i);
+                    --size;
+                    rebalance(prev, node);
+                    return;
+                }
+            }
+        }
+    }
+
+    void traverse() const {
+        forEach([](const T &data) {
+            std::cout << "data: " << data << std::endl;
+        });
+    }
+
+    // in order scan without the printing
+    template<class Func>
+    void forEach(Func f) const {
+        for (Node *node = head; node; node = node->next) {
+            for (int i = 0; i < node->count; ++i) {
+                f(node->at(i));
+            }
+        }
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+private:
+    void rebalance(Node *prev, Node *node) {
+        if (node->count == 0) {
+            unlink(prev, node);
+            return;
+        }
+        Node *next = node->next;
+        if (node->count >= CAPACITY / 2 || !next) {
+            return;
+        }
+        if (node->count + next->count <= CAPACITY) {
+            // both fit in one node - merge the successor into this one
+            while (next->count > 0) {
+                node->insertAt(node->count, std::move(next->at(0)));
+                next->removeAt(0);
+            }
+            unlink(node, next);
+        } else {
+            // borrow from the successor until this node is half full again
+            while (node->count < CAPACITY / 2) {
+                node->insertAt(node->count, std::move(next->at(0)));
+                next->removeAt(0);
+            }
+        }
+    }
+
+    void unlink(Node *prev, Node *node) {
+        if (prev) {
+            prev->next = node->next;
+        } else {
+            head = node->next;
+        }
+        if (tail == node) {
+            tail = prev;
+        }
+        delete node;
+    }
+};
+
+template<class T, int CAPACITY>
+struct UnrolledLinkedList<T, CAPACITY>::Node {
+    // raw storage so T does not have to be default constructible
+    alignas(T) unsigned char items[CAPACITY * sizeof(T)];
+    int count;
+    Node *next;
+
+    Node() : count(0), next(nullptr) {
+    }
+
+    ~Node() {
+        for (int i = 0; i < count; ++i) {
+            at(i).~T();
+        }
+    }
+
+    T &at(int i) {
+        return *std::launder(reinterpret_cast<T *>(items) + i);
+    }
+
+    const T &at(int i) const {
+        return *std::launder(reinterpret_cast<const T *>(items) + i);
+    }
+
+    template<class U>
+    void insertAt(int index, U &&data) {
+        if (index == count) {
+            new(reinterpret_cast<T *>(items) + count) T(std::forward<U>(data));
+        } else {
+            // open a hole at index by shifting the tail one slot to the right
+            new(reinterpret_cast<T *>(items) + count) T(std::move(at(count - 1)));
+            for (int i = count - 1; i > index; --i) {
+                at(i) = std::move(at(i - 1));
+            }
+            at(index) = std::forward<U>(data);
+        }
+        ++count;
+    }
+
+    void removeAt(int index) {
+        for (int i = index; i < count - 1; ++i) {
+            at(i) = std::move(at(i + 1));
+        }
+        at(--count).~T();
+    }
+};
+
+#endif //DATA_STRUCTURES_UNROLLEDLINKLIST_H
@@ -0,0 +1,183 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_BLOCKINGQUEUE_H
+#define DATA_STRUCTURES_BLOCKINGQUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/*
+            Unbounded blocking queue for many producers and consumers
+            consumers spin for a short while and then go to sleep on a condition variable,
+            the bulk operations move a whole batch under a single lock
+                                                                        */
+
+template<class T>
+class BlockingQueue {
+    // how many times a consumer polls the counter before it parks
+    static constexpr int SPIN_LIMIT = 256;
+
+    std::deque<T> items;
+    mutable std::mutex lock;
+    std::condition_variable not_empty;
+
+    // mirror of items.size() so spinning consumers do not touch the lock
+    std::atomic<std::size_t> count;
+    // consumers parked on not_empty (guarded by lock) - producers skip notify when 0
+    int sleeping;
+    bool closed;
+
+public:
+
+    BlockingQueue() : count(0), sleeping(0), closed(false) {}
+
+    BlockingQueue(const BlockingQueue &other) = delete;
+
+    BlockingQueue &operator=(const BlockingQueue &other) = delete;
+
+    bool isEmpty() const {
+        return count.load(std::memory_order_acquire) == 0;
+    }
+
+    std::size_t size() const {
+        return count.load(std::memory_order_acquire);
+    }
+
+    void enqueue(const T &data) {
+        bool wake;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (closed) {
+                throw std::logic_error("Queue is closed.");
+            }
+            items.push_back(data);
+            count.store(items.size(), std::memory_order_release);
+            wake = sleeping > 0;
+        }
+        if (wake) {
+            not_empty.notify_one();
+        }
+    }
+
+    // the whole range is pushed under one lock and wakes the sleepers once
+    template<class Iterator>
+    void enqueueBulk(Iterator first, Iterator last) {
+        std::size_t added = 0;
+        bool wake;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (closed) {
+                throw std::logic_error("Queue is closed.");
+            }
+            for (; first != last; ++first, ++added) {
+                items.push_back(*first);
+            }
+            count.store(items.size(), std::memory_order_release);
+            wake = sleeping > 0 && added > 0;
+        }
+        if (wake) {
+            added == 1 ? not_empty.notify_one() : not_empty.notify_all();
+        }
+    }
+
+    // waits for an item - throws once the queue is closed and drained
+    T dequeue() {
+        T to_dequeue;
+        if (dequeueBulk(&to_dequeue, 1) == 0) {
+            throw std::out_of_range("Queue is closed.");
+        }
+        return to_dequeue;
+    }
+
+    // never waits
+    bool tryDequeue(T &out) {
+        if (isEmpty()) {
+            return false;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        return drain(&out, 1) == 1;
+    }
+
+    // waits up to timeout, false if nothing arrived
+    template<class Rep, class Period>
+    bool dequeueFor(T &out, const std::chrono::duration<Rep, Period> &timeout) {
+        return dequeueBulkFor(&out, 1, timeout) == 1;
+    }
+
+    // waits for at least one item and moves up to max of them into out
+    // returns 0 only when the queue is closed and drained
+    template<class OutputIterator>
+    std::size_t dequeueBulk(OutputIterator out, std::size_t max) {
+        spin();
+        std::unique_lock<std::mutex> guard(lock);
+        if (items.empty() && !closed) {
+            ++sleeping;
+            not_empty.wait(guard, [this] { return !items.empty() || closed; });
+            --sleeping;
+        }
+        return drain(out, max);
+    }
+
+    // like dequeueBulk but gives up after timeout and returns 0
+    template<class OutputIterator, class Rep, class Period>
+    std::size_t dequeueBulkFor(OutputIterator out, std::size_t max,
+                               const std::chrono::duration<Rep, Period> &timeout) {
+        spin();
+        std::unique_lock<std::mutex> guard(lock);
+        if (items.empty() && !closed) {
+            ++sleeping;
+            not_empty.wait_for(guard, timeout, [this] { return !items.empty() || closed; });
+            --sleeping;
+        }
+        return drain(out, max);
+    }
+
+    // wakes every consumer, further enqueues throw
+    void close() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closed = true;
+        }
+        not_empty.notify_all();
+    }
+
+    bool isClosed() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return closed;
+    }
+
+private:
+    // brief busy wait before paying for a sleep/wake
+    void spin() const {
+        for (int i = 0; i < SPIN_LIMIT && isEmpty(); ++i) {
+            if (i >= SPIN_LIMIT / 2) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // lock must be held
+    template<class OutputIterator>
+    std::size_t drain(OutputIterator out, std::size_t max) {
+        std::size_t taken = 0;
+        while (taken < max && !items.empty()) {
+            *out = std::move(items.front());
+            ++out;
+            items.pop_front();
+            ++taken;
+        }
+        count.store(items.size(), std::memory_order_release);
+        return taken;
+    }
+};
+
+#endif //DATA_STRUCTURES_BLOCKINGQUEUE_H
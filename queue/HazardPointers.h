@@ -0,0 +1,177 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_HAZARDPOINTERS_H
+#define DATA_STRUCTURES_HAZARDPOINTERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/*
+            Process wide hazard pointer domain
+            a thread publishes the nodes it is about to dereference, retired nodes are only
+            reclaimed once no thread publishes them
+                                                                        */
+
+class HazardPointers {
+public:
+    // hazard pointers each thread may hold at the same time
+    static constexpr int SLOTS = 2;
+
+    // retired nodes a thread collects before it scans the hazards
+    static constexpr std::size_t SCAN_THRESHOLD = 64;
+
+    // publishes the current value of source in slot and returns it once it is stable
+    template<class Node>
+    static Node *protect(int slot, const std::atomic<Node *> &source) {
+        std::atomic<void *> &hazard = state().record->hazard[slot];
+        Node *p = source.load(std::memory_order_relaxed);
+        while (true) {
+            hazard.store(p, std::memory_order_seq_cst);
+            // the store must be visible before we trust the pointer
+            Node *again = source.load(std::memory_order_seq_cst);
+            if (again == p) {
+                return p;
+            }
+            p = again;
+        }
+    }
+
+    // publishes p as is - the caller must validate it is still reachable afterwards
+    static void set(int slot, void *p) {
+        state().record->hazard[slot].store(p, std::memory_order_seq_cst);
+    }
+
+    static void clear(int slot) {
+        state().record->hazard[slot].store(nullptr, std::memory_order_release);
+    }
+
+    // p is already unlinked - reclaim(p) is called once no thread protects it
+    static void retire(void *p, void (*reclaim)(void *)) {
+        ThreadState &s = state();
+        s.retired.push_back(Retired{p, reclaim});
+        if (s.retired.size() >= SCAN_THRESHOLD) {
+            scan(s);
+        }
+    }
+
+private:
+    struct Record {
+        std::atomic<bool> active;
+        std::atomic<void *> hazard[SLOTS];
+        Record *next;
+
+        Record() : active(false), next(nullptr) {
+            for (std::atomic<void *> &h : hazard) {
+                h.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    struct Retired {
+        void *p;
+        void (*reclaim)(void *);
+    };
+
+    struct ThreadState {
+        Record *record;
+        std::vector<Retired> retired;
+        // scratch space for scan() so it does not allocate every time
+        std::vector<void *> hazards;
+
+        ThreadState() : record(acquireRecord()) {}
+
+        // whatever is still protected by other threads is left for them to reclaim
+        ~ThreadState() {
+            for (std::atomic<void *> &h : record->hazard) {
+                h.store(nullptr, std::memory_order_release);
+            }
+            scan(*this);
+            if (!retired.empty()) {
+                std::lock_guard<std::mutex> guard(orphans.lock);
+                orphans.retired.insert(orphans.retired.end(), retired.begin(), retired.end());
+            }
+            record->active.store(false, std::memory_order_release);
+        }
+    };
+
+    // records are never freed, threads reuse the inactive ones
+    static inline std::atomic<Record *> records{nullptr};
+
+    // retired nodes left behind by exited threads
+    struct Orphans {
+        std::mutex lock;
+        std::vector<Retired> retired;
+
+        // no thread is running by now, nothing can be protected
+        ~Orphans() {
+            for (Retired &r : retired) {
+                r.reclaim(r.p);
+            }
+        }
+    };
+
+    static inline Orphans orphans;
+
+    static ThreadState &state() {
+        thread_local ThreadState s;
+        return s;
+    }
+
+    static Record *acquireRecord() {
+        for (Record *r = records.load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (!r->active.load(std::memory_order_relaxed) &&
+                r->active.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return r;
+            }
+        }
+
+        Record *r = new Record();
+        r->active.store(true, std::memory_order_relaxed);
+        Record *old = records.load(std::memory_order_relaxed);
+        do {
+            r->next = old;
+        } while (!records.compare_exchange_weak(old, r, std::memory_order_release, std::memory_order_relaxed));
+        return r;
+    }
+
+    static void scan(ThreadState &s) {
+        // adopt nodes left behind by exited threads, but never wait for it
+        std::unique_lock<std::mutex> guard(orphans.lock, std::try_to_lock);
+        if (guard && !orphans.retired.empty()) {
+            s.retired.insert(s.retired.end(), orphans.retired.begin(), orphans.retired.end());
+            orphans.retired.clear();
+        }
+        if (guard) {
+            guard.unlock();
+        }
+
+        s.hazards.clear();
+        for (Record *r = records.load(std::memory_order_acquire); r; r = r->next) {
+            for (std::atomic<void *> &h : r->hazard) {
+                void *p = h.load(std::memory_order_seq_cst);
+                if (p) {
+                    s.hazards.push_back(p);
+                }
+            }
+        }
+        std::sort(s.hazards.begin(), s.hazards.end());
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < s.retired.size(); ++i) {
+            if (std::binary_search(s.hazards.begin(), s.hazards.end(), s.retired[i].p)) {
+                s.retired[kept++] = s.retired[i];
+            } else {
+                s.retired[i].reclaim(s.retired[i].p);
+            }
+        }
+        s.retired.resize(kept);
+    }
+};
+
+#endif //DATA_STRUCTURES_HAZARDPOINTERS_H
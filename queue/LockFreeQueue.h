@@ -0,0 +1,247 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_LOCKFREEQUEUE_H
+#define DATA_STRUCTURES_LOCKFREEQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "HazardPointers.h"
+
+/*
+            Unbounded lock free queue (Michael & Scott)
+            head always points to a dummy node, the first item lives in head->next.
+            unlinked nodes are reclaimed through hazard pointers and recycled through a
+            per thread cache, so steady state enqueue/dequeue does not allocate
+                                                                        */
+
+template<class T>
+class LockFreeQueue {
+    struct Node;
+
+    // nodes each thread keeps before it spills a batch to the shared pool
+    static constexpr std::size_t BATCH = 64;
+
+    alignas(64) std::atomic<Node *> head;
+    alignas(64) std::atomic<Node *> tail;
+
+    char padding[64 - sizeof(std::atomic<Node *>)];
+
+public:
+
+    LockFreeQueue() {
+        Node *dummy = allocate();
+        head.store(dummy, std::memory_order_relaxed);
+        tail.store(dummy, std::memory_order_relaxed);
+    }
+
+    // no other thread may use the queue while it is destroyed
+    ~LockFreeQueue() {
+        Node *it = head.load(std::memory_order_relaxed);
+        while (it) {
+            Node *next = it->getNext();
+            delete it;
+            it = next;
+        }
+    }
+
+    LockFreeQueue(const LockFreeQueue &other) = delete;
+
+    LockFreeQueue &operator=(const LockFreeQueue &other) = delete;
+
+    bool isEmpty() const {
+        Node *first = HazardPointers::protect(0, head);
+        bool empty = first->getNext() == nullptr;
+        HazardPointers::clear(0);
+        return empty;
+    }
+
+    void enqueue(const T &data) {
+        Node *node = allocate();
+        node->setData(data);
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        while (true) {
+            Node *last = HazardPointers::protect(0, tail);
+            Node *next = last->next.load(std::memory_order_acquire);
+
+            if (last != tail.load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            if (next == nullptr) {
+                // link after the real last node, then try to swing tail (someone may help us)
+                if (last->next.compare_exchange_weak(next, node, std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+                    tail.compare_exchange_strong(last, node, std::memory_order_release, std::memory_order_relaxed);
+                    break;
+                }
+            } else {
+                // tail is lagging behind - help the other producer
+                tail.compare_exchange_weak(last, next, std::memory_order_release, std::memory_order_relaxed);
+            }
+        }
+
+        HazardPointers::clear(0);
+    }
+
+    // false when the queue is empty
+    bool tryDequeue(T &out) {
+        while (true) {
+            Node *first = HazardPointers::protect(0, head);
+            Node *last = tail.load(std::memory_order_acquire);
+            Node *next = first->next.load(std::memory_order_acquire);
+            HazardPointers::set(1, next);
+
+            // first is still the head, so next is still linked and now protected
+            if (first != head.load(std::memory_order_seq_cst)) {
+                continue;
+            }
+
+            if (next == nullptr) {
+                HazardPointers::clear(0);
+                HazardPointers::clear(1);
+                return false;
+            }
+
+            if (first == last) {
+                // tail is lagging behind the node we are about to consume
+                tail.compare_exchange_weak(last, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+
+            if (head.compare_exchange_strong(first, next)) {
+                // next becomes the new dummy, only the winner reads its data
+                out = std::move(next->data);
+                HazardPointers::clear(0);
+                HazardPointers::clear(1);
+                HazardPointers::retire(first, &recycle);
+                return true;
+            }
+        }
+    }
+
+    T dequeue() {
+        T to_dequeue;
+        if (!tryDequeue(to_dequeue)) {
+            throw std::out_of_range("Queue is empty.");
+        }
+        return to_dequeue;
+    }
+
+private:
+    // per thread cache of reclaimed nodes
+    struct NodeCache {
+        std::vector<Node *> nodes;
+
+        ~NodeCache() {
+            for (Node *node : nodes) {
+                delete node;
+            }
+            cacheDead() = true;
+        }
+    };
+
+    // nodes moved between threads in batches (producers and consumers are often different threads)
+    struct NodePool {
+        std::mutex lock;
+        std::vector<Node *> nodes;
+
+        ~NodePool() {
+            for (Node *node : nodes) {
+                delete node;
+            }
+        }
+    };
+
+    static inline NodePool pool;
+
+    // set once this thread's cache is destroyed - late reclaims go straight to delete
+    static bool &cacheDead() {
+        thread_local bool dead = false;
+        return dead;
+    }
+
+    static NodeCache &cache() {
+        thread_local NodeCache c;
+        return c;
+    }
+
+    static Node *allocate() {
+        if (!cacheDead()) {
+            std::vector<Node *> &nodes = cache().nodes;
+            if (nodes.empty()) {
+                refill(nodes);
+            }
+            if (!nodes.empty()) {
+                Node *node = nodes.back();
+                nodes.pop_back();
+                return node;
+            }
+        }
+        return new Node();
+    }
+
+    // reclaim callback handed to HazardPointers::retire
+    static void recycle(void *p) {
+        Node *node = static_cast<Node *>(p);
+        if (cacheDead()) {
+            delete node;
+            return;
+        }
+        std::vector<Node *> &nodes = cache().nodes;
+        nodes.push_back(node);
+        if (nodes.size() >= 2 * BATCH) {
+            spill(nodes);
+        }
+    }
+
+    // the pool is only ever try-locked, a busy pool just means one more new/keep
+    static void refill(std::vector<Node *> &nodes) {
+        std::unique_lock<std::mutex> guard(pool.lock, std::try_to_lock);
+        for (std::size_t i = 0; guard && i < BATCH && !pool.nodes.empty(); ++i) {
+            nodes.push_back(pool.nodes.back());
+            pool.nodes.pop_back();
+        }
+    }
+
+    static void spill(std::vector<Node *> &nodes) {
+        std::unique_lock<std::mutex> guard(pool.lock, std::try_to_lock);
+        for (std::size_t i = 0; guard && i < BATCH; ++i) {
+            pool.nodes.push_back(nodes.back());
+            nodes.pop_back();
+        }
+    }
+};
+
+template<class T>
+struct LockFreeQueue<T>::Node {
+    // stored inline (unlike Queue<T>::Node) so recycling a node recycles its payload too
+    T data;
+    std::atomic<Node *> next;
+
+    explicit Node() : data(), next(nullptr) {}
+
+    const T &getData() const {
+        return data;
+    }
+
+    void setData(const T &_data) {
+        data = _data;
+    }
+
+    Node *getNext() const {
+        return next.load(std::memory_order_acquire);
+    }
+
+    void setNext(Node *_next) {
+        next.store(_next, std::memory_order_release);
+    }
+};
+
+#endif //DATA_STRUCTURES_LOCKFREEQUEUE_H
@@ -0,0 +1,167 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_MPMCQUEUE_H
+#define DATA_STRUCTURES_MPMCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/*
+            Bounded multi producer / multi consumer queue (Vyukov)
+            every cell carries a sequence number telling who may touch it next
+                                                                        */
+
+template<class T>
+class MPMCQueue {
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    struct Cell;
+
+    std::size_t capacity;
+    std::size_t mask;
+    Cell *buffer;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_pos;
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_pos;
+
+    char padding[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+
+public:
+
+    // the capacity is rounded up to a power of two (at least 2)
+    explicit MPMCQueue(std::size_t _capacity = 1024) : capacity(roundUp(_capacity)), mask(capacity - 1),
+                                                      buffer(new Cell[capacity]), enqueue_pos(0),
+                                                      dequeue_pos(0) {
+        // cell i is free for the producer that claims position i
+        for (std::size_t i = 0; i < capacity; ++i) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MPMCQueue() {
+        delete[] buffer;
+    }
+
+    MPMCQueue(const MPMCQueue &other) = delete;
+
+    MPMCQueue &operator=(const MPMCQueue &other) = delete;
+
+    // lock free, false when the queue is full
+    bool tryEnqueue(const T &data) {
+        Cell *cell;
+        std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+
+        while (true) {
+            cell = &buffer[pos & mask];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = (std::intptr_t) seq - (std::intptr_t) pos;
+
+            if (diff == 0) {
+                // the cell is free - try to claim the position
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the cell still holds an item from the previous lap
+                return false;
+            } else {
+                // another producer got here first
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = data;
+        // publish to the consumer that will claim position pos
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // lock free, false when the queue is empty
+    bool tryDequeue(T &out) {
+        Cell *cell;
+        std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+
+        while (true) {
+            cell = &buffer[pos & mask];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = (std::intptr_t) seq - (std::intptr_t) (pos + 1);
+
+            if (diff == 0) {
+                // the cell is full - try to claim the position
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // nothing has been published here yet
+                return false;
+            } else {
+                // another consumer got here first
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(cell->data);
+        // hand the cell to the producer of the next lap
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // waits until there is room
+    void enqueue(const T &data) {
+        while (!tryEnqueue(data)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // waits until there is an item
+    T dequeue() {
+        T to_dequeue;
+        while (!tryDequeue(to_dequeue)) {
+            std::this_thread::yield();
+        }
+        return to_dequeue;
+    }
+
+    // a snapshot only - other threads may change it right away
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    std::size_t size() const {
+        std::size_t out = dequeue_pos.load(std::memory_order_acquire);
+        std::size_t in = enqueue_pos.load(std::memory_order_acquire);
+        return in > out ? in - out : 0;
+    }
+
+    std::size_t getCapacity() const {
+        return capacity;
+    }
+
+private:
+    static std::size_t roundUp(std::size_t n) {
+        if (n == 0) {
+            throw std::invalid_argument("MPMCQueue capacity must be positive");
+        }
+        std::size_t power = 2;
+        while (power < n) {
+            power <<= 1;
+        }
+        return power;
+    }
+};
+
+template<class T>
+struct MPMCQueue<T>::Cell {
+    std::atomic<std::size_t> sequence;
+    T data;
+
+    Cell() : sequence(0), data() {}
+};
+
+#endif //DATA_STRUCTURES_MPMCQUEUE_H
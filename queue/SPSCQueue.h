@@ -0,0 +1,131 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+#ifndef DATA_STRUCTURES_SPSCQUEUE_H
+#define DATA_STRUCTURES_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/*
+            Bounded single producer / single consumer ring buffer
+            exactly one thread enqueues and exactly one thread dequeues
+                                                                        */
+
+template<class T>
+class SPSCQueue {
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::size_t capacity;
+    std::size_t mask;
+    T *buffer;
+
+    // consumer side: next slot to read + last tail it has seen
+    alignas(CACHE_LINE) std::atomic<std::size_t> head;
+    std::size_t cached_tail;
+
+    // producer side: next slot to write + last head it has seen
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail;
+    std::size_t cached_head;
+
+    // keeps the producer line away from whatever follows the queue in memory
+    char padding[CACHE_LINE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+
+public:
+
+    // the capacity is rounded up to a power of two so wrapping is a single mask
+    explicit SPSCQueue(std::size_t _capacity = 1024) : capacity(roundUp(_capacity)), mask(capacity - 1),
+                                                      buffer(new T[capacity]), head(0), cached_tail(0),
+                                                      tail(0), cached_head(0) {
+    }
+
+    ~SPSCQueue() {
+        delete[] buffer;
+    }
+
+    SPSCQueue(const SPSCQueue &other) = delete;
+
+    SPSCQueue &operator=(const SPSCQueue &other) = delete;
+
+    // producer only - O(1), false when the ring is full
+    bool tryEnqueue(const T &data) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+
+        // only go to the shared head when our snapshot says the ring is full
+        if (t - cached_head == capacity) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (t - cached_head == capacity) {
+                return false;
+            }
+        }
+
+        buffer[t & mask] = data;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer only - O(1), false when the ring is empty
+    bool tryDequeue(T &out) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+
+        // only go to the shared tail when our snapshot says the ring is empty
+        if (h == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h == cached_tail) {
+                return false;
+            }
+        }
+
+        out = std::move(buffer[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // producer only - waits until there is room
+    void enqueue(const T &data) {
+        while (!tryEnqueue(data)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // consumer only - waits until there is an item
+    T dequeue() {
+        T to_dequeue;
+        while (!tryDequeue(to_dequeue)) {
+            std::this_thread::yield();
+        }
+        return to_dequeue;
+    }
+
+    // exact when called from one of the two sides, a snapshot otherwise
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    std::size_t size() const {
+        const std::size_t h = head.load(std::memory_order_acquire);
+        return tail.load(std::memory_order_acquire) - h;
+    }
+
+    std::size_t getCapacity() const {
+        return capacity;
+    }
+
+private:
+    static std::size_t roundUp(std::size_t n) {
+        if (n == 0) {
+            throw std::invalid_argument("SPSCQueue capacity must be positive");
+        }
+        std::size_t power = 1;
+        while (power < n) {
+            power <<= 1;
+        }
+        return power;
+    }
+};
+
+#endif //DATA_STRUCTURES_SPSCQUEUE_H
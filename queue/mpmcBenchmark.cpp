@@ -0,0 +1,81 @@
+//
+// Created by USER on 19/10/2026.
+//
+
+// throughput of MPMCQueue with producers and consumers scaled independently
+//     g++ -std=c++17 -O2 -pthread mpmcBenchmark.cpp -o mpmcBenchmark
+//     ./mpmcBenchmark <producers> <consumers> [items per producer = 1000000] [capacity = 1024]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MPMCQueue.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <producers> <consumers> [items per producer] [capacity]" << std::endl;
+        return 1;
+    }
+    int producers = std::atoi(argv[1]);
+    int consumers = std::atoi(argv[2]);
+    long long per_producer = argc > 3 ? std::atoll(argv[3]) : 1000000;
+    std::size_t capacity = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1024;
+    if (producers <= 0 || consumers <= 0 || per_producer <= 0 || capacity == 0) {
+        std::cerr << "every count must be positive" << std::endl;
+        return 1;
+    }
+
+    MPMCQueue<std::uint64_t> queue(capacity);
+    long long total = producers * per_producer;
+    // consumers claim an item before they wait for it, so none waits for an item that never comes
+    std::atomic<long long> claimed(0);
+    std::atomic<std::uint64_t> checksum(0);
+    std::atomic<bool> start(false);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (long long i = 0; i < per_producer; ++i) {
+                queue.enqueue((std::uint64_t) p * per_producer + i);
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::uint64_t sum = 0;
+            while (claimed.fetch_add(1, std::memory_order_relaxed) < total) {
+                sum += queue.dequeue();
+            }
+            checksum.fetch_add(sum, std::memory_order_relaxed);
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    // every item 0 .. total - 1 went through exactly once
+    std::uint64_t expected = (std::uint64_t) total * (total - 1) / 2;
+    if (checksum.load() != expected) {
+        std::cerr << "checksum mismatch: " << checksum.load() << " != " << expected << std::endl;
+        return 1;
+    }
+    std::cout << producers << " producers, " << consumers << " consumers, capacity " << queue.getCapacity()
+              << ": " << total << " items in " << seconds << " s, " << total / seconds / 1e6 << " M items/s"
+              << std::endl;
+    return 0;
+}
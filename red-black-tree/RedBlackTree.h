@@ -6,6 +6,11 @@
 #define DATA_STRUCTURES_REDBLACKTREE_H
 
 #include <ostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "../binary-search-tree/EytzingerSet.h"
+#include "../binary-search-tree/NodeBlock.h"
 
 enum Color {
     RED, BLACK
@@ -16,6 +21,8 @@ class RedBlackTree {
 
     struct Node;
     Node *root;
+    // the nodes of fromSorted(), the others are allocated one by one
+    NodeBlock<Node, T> block;
 
     // no option for copy constructor
     RedBlackTree<T> &operator=(const RedBlackTree<T> &avl) = default;
@@ -24,15 +31,28 @@ public:
     RedBlackTree() : root(new Node()) {}
 
     ~RedBlackTree() {
-        delete root;
+        destroy(root);
     }
 
+    // other is left without a root node - it gets a new one on its next insert
+    RedBlackTree(RedBlackTree &&other) noexcept : root(other.root) {
+        other.root = nullptr;
+        block.swap(other.block);
+    }
+
+    // a balanced tree over a sorted range - O(n), no comparisons, and all the nodes in one allocation
+    template<class Iterator>
+    static RedBlackTree fromSorted(Iterator first, Iterator last);
+
     void insert(const T &data);
 
     void remove(const T &data);
 
     void traverse();
 
+    // an immutable copy laid out for fast lookups (../binary-search-tree/EytzingerSet.h) - O(n)
+    EytzingerSet<T> freeze() const;
+
 private:
     // should be static funcs
 
@@ -47,6 +67,25 @@ private:
 
     void traverse(Node *node);
 
+    // appends the items of the subtree in order
+    static void collect(const Node *node, std::vector<T> &items);
+
+    // the items [lo, hi) of the range first points into, as a balanced subtree
+    // the nodes at red_depth are red, the rest black
+    template<class Iterator>
+    static Node *build(NodeBlock<Node, T> &nodes, Iterator &first, std::size_t lo, std::size_t hi, int depth, int red_depth);
+
+    // frees the subtree without recursion
+    void destroy(Node *node);
+
+    void freeNode(Node *node) {
+        if (block.owns(node)) {
+            block.destroy(node);
+        } else {
+            delete node;
+        }
+    }
+
     void settleViolations(Node *node);
 
     void leftRotation(Node *node);
@@ -89,10 +128,8 @@ struct RedBlackTree<T>::Node {
 
     Node &operator=(const Node &other) = default;
 
-    // parent deleted by previous calls
+    // the children are freed by the tree (see destroy)
     ~Node() {
-        delete left;
-        delete right;
         delete data;
     }
 
@@ -146,6 +183,10 @@ struct RedBlackTree<T>::Node {
 
 template<class T>
 void RedBlackTree<T>::insert(const T &data) {
+    // a moved-from tree
+    if (root == nullptr) {
+        root = new Node();
+    }
     if (root->data == nullptr) {
         root->setData(new T(data));
         settleViolations(root);
@@ -390,7 +431,7 @@ void RedBlackTree<T>::caseRightChild(RedBlackTree::Node *node) {
         }
     }
     node->right = nullptr;
-    delete node;
+    freeNode(node);
     settleViolations(right);
 }
 
@@ -409,7 +450,7 @@ void RedBlackTree<T>::caseLeftChild(RedBlackTree::Node *node) {
         }
     }
     node->left = nullptr;
-    delete node;
+    freeNode(node);
     settleViolations(left);
 }
 
@@ -417,7 +458,7 @@ template<class T>
 void RedBlackTree<T>::removeLeaf(RedBlackTree::Node *leaf) {
     Node *parent = leaf->getParent();
     if (root == leaf) {
-        delete root;
+        freeNode(root);
         root = new Node();
     } else {
         if (parent->getLeft() == leaf) {
@@ -425,7 +466,7 @@ void RedBlackTree<T>::removeLeaf(RedBlackTree::Node *leaf) {
         } else {
             parent->setRight(nullptr);
         }
-        delete leaf;
+        freeNode(leaf);
         settleViolations(parent);
     }
 }
@@ -437,9 +478,11 @@ void RedBlackTree<T>::caseTwoChildren(RedBlackTree::Node *node) {
     Node *parent = node->getParent();
     Node *predecessor = getPredecessor(left);
     Node *predecessor_parent = predecessor->getParent();
+    Node *predecessor_left = predecessor->getLeft();
 
     predecessor->setParent(parent);
     predecessor->setRight(right);
+    right->setParent(predecessor);
 
     if (parent != nullptr) {
         if (parent->getRight() == node) {
@@ -451,20 +494,114 @@ void RedBlackTree<T>::caseTwoChildren(RedBlackTree::Node *node) {
 
     node->setLeft(nullptr);
     node->setRight(nullptr);
+    if (root == node) {
+        root = predecessor;
+    }
 
     if (left == predecessor) {
-        if (root == node) {
-            root = predecessor;
-        }
-        predecessor->setLeft(nullptr);
-        delete node;
+        freeNode(node);
         settleViolations(predecessor);
     } else {
         predecessor->setLeft(left);
-        delete node;
-        predecessor_parent->setRight(nullptr);
+        left->setParent(predecessor);
+        freeNode(node);
+        // the predecessor's left subtree takes its place
+        predecessor_parent->setRight(predecessor_left);
+        if (predecessor_left) {
+            predecessor_left->setParent(predecessor_parent);
+        }
         settleViolations(predecessor_parent);
     }
 }
 
+template<class T>
+EytzingerSet<T> RedBlackTree<T>::freeze() const {
+    std::vector<T> items;
+    // an empty tree is a root without data
+    if (root && root->data) {
+        collect(root, items);
+    }
+    return EytzingerSet<T>(std::move(items));
+}
+
+template<class T>
+void RedBlackTree<T>::collect(const RedBlackTree::Node *node, std::vector<T> &items) {
+    if (!node) {
+        return;
+    }
+    collect(node->getLeft(), items);
+    items.push_back(*node->data);
+    collect(node->getRight(), items);
+}
+
+template<class T>
+template<class Iterator>
+RedBlackTree<T> RedBlackTree<T>::fromSorted(Iterator first, Iterator last) {
+    RedBlackTree<T> tree;
+    std::size_t count = std::distance(first, last);
+    if (count == 0) {
+        return tree;
+    }
+    // halving keeps every leaf on the last two levels - painting the deepest level red
+    // leaves the same number of black nodes on every path
+    int red_depth = 0;
+    while ((std::size_t) 2 << red_depth <= count) {
+        ++red_depth;
+    }
+    tree.block.allocate(count);
+    Node *built;
+    try {
+        built = build(tree.block, first, 0, count, 0, red_depth);
+    } catch (...) {
+        tree.block.destroyAll();
+        throw;
+    }
+    built->setColor(BLACK);
+    // replaces the empty root
+    delete tree.root;
+    tree.root = built;
+    return tree;
+}
+
+template<class T>
+template<class Iterator>
+typename RedBlackTree<T>::Node *RedBlackTree<T>::build(NodeBlock<Node, T> &nodes, Iterator &first, std::size_t lo, std::size_t hi, int depth, int red_depth) {
+    if (lo == hi) {
+        return nullptr;
+    }
+    // the middle item is the root, built in order so the block is in order too
+    std::size_t mid = lo + (hi - lo) / 2;
+    Node *left = build(nodes, first, lo, mid, depth + 1, red_depth);
+    Node *node = nodes.create(*first);
+    ++first;
+    Node *right = build(nodes, first, mid + 1, hi, depth + 1, red_depth);
+    node->setLeft(left);
+    node->setRight(right);
+    if (left) {
+        left->setParent(node);
+    }
+    if (right) {
+        right->setParent(node);
+    }
+    node->setColor(depth == red_depth ? RED : BLACK);
+    return node;
+}
+
+template<class T>
+void RedBlackTree<T>::destroy(RedBlackTree::Node *node) {
+    // rotate left children up until there is none, then the node can go
+    while (node) {
+        if (node->left) {
+            Node *left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            Node *right = node->right;
+            freeNode(node);
+            node = right;
+        }
+    }
+}
+
 #endif //DATA_STRUCTURES_REDBLACKTREE_H